@@ -0,0 +1,77 @@
+#pragma once
+
+// Library includes
+#include "bento_base/log.h"
+#include "bento_collection/mpmc_queue.h"
+
+// External includes
+#include <atomic>
+#include <thread>
+#include <stdio.h>
+#include <string.h>
+
+namespace bento {
+
+	// Sizes of the fixed size log records, longer tags and messages are truncated
+	const uint32_t LOG_RECORD_TAG_SIZE = 32;
+	const uint32_t LOG_RECORD_MESSAGE_SIZE = 220;
+
+	struct LogRecord
+	{
+		LogLevel::Type level;
+		bool new_line;
+		char tag[LOG_RECORD_TAG_SIZE];
+		char message[LOG_RECORD_MESSAGE_SIZE];
+	};
+
+	// Copy a tag or a message in a record field
+	inline void copy_truncated(char* target, const char* source, uint32_t target_size)
+	{
+		size_t length = source != nullptr ? strlen(source) : 0;
+		length = length < target_size - 1 ? length : target_size - 1;
+		memcpy(target, source, length);
+		target[length] = '\0';
+	}
+
+	// Logger that copies the records in a lock-free queue and writes them from a background thread.
+	// Logging never blocks, records are dropped (and counted) when the queue is full.
+	class AsyncLogger : public ILogger
+	{
+	public:
+		ALLOCATOR_BASED;
+
+		// Cst & Dst, the records go to the standard output if no file is given (or if it can't be opened)
+		AsyncLogger(IAllocator& allocator, uint32_t capacity = 4096, const char* file_path = nullptr);
+		~AsyncLogger();
+
+		// ILogger interface
+		void log(LogLevel::Type log_level, const char* tag, const char* message) override;
+		void new_line() override;
+
+		// Wait until every record logged so far has been written
+		void flush() override;
+
+		// Number of records that were dropped because the queue was full
+		inline uint64_t num_dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+	private:
+		void push(const LogRecord& record);
+		void drain();
+		void write_record(const LogRecord& record);
+
+		// Non copyable
+		AsyncLogger(const AsyncLogger&);
+		AsyncLogger& operator=(const AsyncLogger&);
+
+	private:
+		MPMCQueue<LogRecord> _records;
+		FILE* _output;
+		bool _owns_output;
+		std::thread _thread;
+		std::atomic<bool> _running;
+		std::atomic<uint64_t> _pushed;
+		std::atomic<uint64_t> _written;
+		std::atomic<uint64_t> _dropped;
+		uint64_t _reported_dropped;
+	};
+}
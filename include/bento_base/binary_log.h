@@ -0,0 +1,88 @@
+#pragma once
+
+// Library includes
+#include "bento_base/log.h"
+#include "bento_collection/vector.h"
+#include "bento_collection/dynamic_string.h"
+
+// External includes
+#include <stdint.h>
+#include <string.h>
+
+namespace bento {
+
+	// Deferred logging: the call site only records the id of its static format string and the raw bytes of its arguments
+	// in a per-thread buffer. Full buffers are handed to a sink, the text is produced later by binary_log::decode.
+	namespace binary_log
+	{
+		// Receives the full per-thread buffers, it is called from the logging threads and must be thread-safe
+		typedef void (*Sink)(const char* data, uint32_t size, void* user_data);
+
+		// Size of the per-thread buffers, records that do not fit in an empty buffer are dropped
+		const uint32_t THREAD_BUFFER_SIZE = 64 * 1024;
+
+		// Longest string argument that is recorded, longer ones are truncated
+		const uint32_t MAX_STRING_ARGUMENT_SIZE = 256;
+
+		// Type of a recorded argument
+		namespace ArgType
+		{
+			enum Type
+			{
+				int32 = 0,
+				uint32 = 1,
+				int64 = 2,
+				uint64 = 3,
+				real = 4,
+				string = 5,
+				pointer = 6,
+			};
+		}
+
+		// A normalized argument, built on the stack of the call site
+		struct Arg
+		{
+			uint32_t type;
+			uint32_t size;
+			uint64_t bits;
+			const char* str;
+		};
+
+		// Register a format site and get its id (called once per call site by bento_binary_log)
+		uint32_t register_site(LogLevel::Type log_level, const char* tag, const char* format, const char* file, uint32_t line);
+
+		// Set the sink the buffers are flushed to (nullptr discards them), should be set before logging starts
+		void set_sink(Sink sink, void* user_data);
+
+		// Record a log entry in the buffer of the calling thread
+		void write_record(uint32_t site_id, const Arg* args, uint32_t num_args);
+
+		template<typename... Ts>
+		void write(uint32_t site_id, const Ts&... values);
+
+		// Hand the buffer of the calling thread to the sink (also done when the thread exits)
+		void flush_thread();
+
+		// Number of records that were too big for a thread buffer
+		uint64_t num_dropped();
+
+		// Serialize the format sites registered so far, the decoder needs it to turn the records into text
+		void dump_dictionary(Vector<char>& output);
+
+		// Turn a sequence of flushed buffers into "[LEVEL][tag]message" lines, returns false if the data is corrupted
+		bool decode(const char* dictionary, uint32_t dictionary_size, const char* data, uint64_t data_size, DynamicString& output);
+	}
+}
+
+#include "binary_log.inl"
+
+// Record a log entry, the format string follows the printf syntax and must be a literal.
+// The records go through the same level filters as the text logs (there is no rate limiting).
+#define bento_binary_log(LEVEL, TAG, FORMAT, ...) \
+	do { \
+		if ((LEVEL) >= BENTO_LOG_MIN_LEVEL && (LEVEL) >= bento::min_log_level()) \
+		{ \
+			static const uint32_t __bento_site_id = bento::binary_log::register_site(LEVEL, TAG, FORMAT, __FILE__, __LINE__); \
+			bento::binary_log::write(__bento_site_id, ##__VA_ARGS__); \
+		} \
+	} while (0)
@@ -0,0 +1,64 @@
+
+namespace bento
+{
+	namespace binary_log
+	{
+		inline Arg make_signed_arg(int64_t value, uint32_t type)
+		{
+			Arg arg = { type, type == ArgType::int32 ? 4u : 8u, (uint64_t)value, nullptr };
+			return arg;
+		}
+
+		inline Arg make_unsigned_arg(uint64_t value, uint32_t type)
+		{
+			Arg arg = { type, type == ArgType::uint32 ? 4u : 8u, value, nullptr };
+			return arg;
+		}
+
+		// Every argument is normalized to one of the recorded types
+		inline Arg make_arg(bool value) { return make_signed_arg(value ? 1 : 0, ArgType::int32); }
+		inline Arg make_arg(char value) { return make_signed_arg(value, ArgType::int32); }
+		inline Arg make_arg(signed char value) { return make_signed_arg(value, ArgType::int32); }
+		inline Arg make_arg(short value) { return make_signed_arg(value, ArgType::int32); }
+		inline Arg make_arg(int value) { return make_signed_arg(value, ArgType::int32); }
+		inline Arg make_arg(long value) { return make_signed_arg(value, sizeof(long) == 4 ? ArgType::int32 : ArgType::int64); }
+		inline Arg make_arg(long long value) { return make_signed_arg(value, ArgType::int64); }
+		inline Arg make_arg(unsigned char value) { return make_unsigned_arg(value, ArgType::uint32); }
+		inline Arg make_arg(unsigned short value) { return make_unsigned_arg(value, ArgType::uint32); }
+		inline Arg make_arg(unsigned int value) { return make_unsigned_arg(value, ArgType::uint32); }
+		inline Arg make_arg(unsigned long value) { return make_unsigned_arg(value, sizeof(unsigned long) == 4 ? ArgType::uint32 : ArgType::uint64); }
+		inline Arg make_arg(unsigned long long value) { return make_unsigned_arg(value, ArgType::uint64); }
+
+		inline Arg make_arg(double value)
+		{
+			Arg arg = { ArgType::real, 8, 0, nullptr };
+			memcpy(&arg.bits, &value, sizeof(double));
+			return arg;
+		}
+
+		inline Arg make_arg(float value) { return make_arg((double)value); }
+
+		inline Arg make_arg(const char* value)
+		{
+			// Strings are copied with a 16 bits length prefix
+			size_t length = value != nullptr ? strlen(value) : 0;
+			length = length < MAX_STRING_ARGUMENT_SIZE ? length : MAX_STRING_ARGUMENT_SIZE;
+			Arg arg = { ArgType::string, 2 + (uint32_t)length, length, value };
+			return arg;
+		}
+
+		inline Arg make_arg(const void* value)
+		{
+			Arg arg = { ArgType::pointer, 8, (uint64_t)(uintptr_t)value, nullptr };
+			return arg;
+		}
+
+		template<typename... Ts>
+		void write(uint32_t site_id, const Ts&... values)
+		{
+			// The extra element keeps the array valid when there are no arguments
+			Arg args[sizeof...(Ts) + 1] = { make_arg(values)..., make_arg(0) };
+			write_record(site_id, args, (uint32_t)sizeof...(Ts));
+		}
+	}
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// Library includes
+#include "bento_base/platform.h"
+
+namespace bento {
+
+	// CRC32C (Castagnoli) of a buffer. Uses the SSE4.2 crc32 instruction when the CPU supports it and a slicing-by-8 table otherwise.
+	// The checksum of a buffer split in pieces is obtained by passing the result of the previous piece as crc.
+	uint32_t crc32c(const void* data, uint64_t size, uint32_t crc = 0);
+}
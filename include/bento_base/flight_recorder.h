@@ -0,0 +1,62 @@
+#pragma once
+
+// Library includes
+#include "bento_base/async_logger.h"
+
+// External includes
+#include <atomic>
+
+namespace bento {
+
+	// Logger that keeps the last records in a circular memory buffer, nothing is written until the buffer is dumped.
+	// Once installed it records every message (even the ones the level filters discard) and dumps them when
+	// __handle_fail fires or when the program receives a fatal signal.
+	class FlightRecorderLogger : public ILogger
+	{
+	public:
+		ALLOCATOR_BASED;
+
+		// Cst & Dst, the dumps go to the standard error if no file is given
+		FlightRecorderLogger(IAllocator& allocator, uint32_t capacity = 1024, const char* dump_path = nullptr);
+		~FlightRecorderLogger();
+
+		// ILogger interface
+		void log(LogLevel::Type log_level, const char* tag, const char* message) override;
+		void new_line() override;
+
+		// Become the log recorder and dump on failures (and on SIGSEGV, SIGABRT, SIGFPE, SIGILL and SIGBUS if requested).
+		// The signals are chained to the handlers the application had, uninstall restores them.
+		// Only one flight recorder can be installed at a time.
+		void install(bool handle_signals = true);
+		void uninstall();
+
+		// Write the recorded history, oldest record first (async-signal-safe)
+		void dump(int file_descriptor) const;
+
+		// Write the recorded history to the dump file or to the standard error (async-signal-safe)
+		void dump() const;
+
+	private:
+		struct Slot
+		{
+			// Index of the record held by the slot, UINT64_MAX while it is being written
+			std::atomic<uint64_t> sequence;
+			LogRecord record;
+		};
+
+		Slot& acquire_slot(uint64_t& sequence);
+
+		// Non copyable
+		FlightRecorderLogger(const FlightRecorderLogger&);
+		FlightRecorderLogger& operator=(const FlightRecorderLogger&);
+
+	private:
+		IAllocator& _allocator;
+		Slot* _slots;
+		uint32_t _capacity;
+		std::atomic<uint64_t> _next;
+		char _dump_path[256];
+		bool _installed;
+		bool _handles_signals;
+	};
+}
@@ -8,4 +8,101 @@ namespace bento {
 	// Implementation taken from https://sites.google.com/site/murmurhash/
 	uint32_t murmur_hash(const void * key, uint32_t len, uint32_t seed);
 	uint64_t murmur_hash_64(const void * key, uint32_t len, uint32_t seed);
+
+	// Same as murmur_hash_64 on the ascii lower case version of the key (without building it)
+	uint64_t murmur_hash_64_lower_case(const void * key, uint32_t len, uint32_t seed);
+
+	// Compile time version of murmur_hash_64, written with single return recursions to stay C++11 constexpr
+	namespace constexpr_murmur
+	{
+		const uint64_t m = 0xc6a4a7935bd1e995ull;
+		const int r = 47;
+
+		// Little endian read of size bytes
+		constexpr uint64_t read(const char* key, uint32_t idx, uint32_t size)
+		{
+			return size == 0 ? 0 : (uint64_t)(unsigned char)key[idx] | (read(key, idx + 1, size - 1) << 8);
+		}
+
+		constexpr uint64_t mix_word(uint64_t k)
+		{
+			return ((k * m) ^ ((k * m) >> r)) * m;
+		}
+
+		constexpr uint64_t body(const char* key, uint32_t idx, uint32_t num_words, uint64_t h)
+		{
+			return num_words == 0 ? h : body(key, idx + 8, num_words - 1, (h ^ mix_word(read(key, idx, 8))) * m);
+		}
+
+		constexpr uint64_t tail(const char* key, uint32_t idx, uint32_t size, uint64_t h)
+		{
+			return size == 0 ? h : (h ^ read(key, idx, size)) * m;
+		}
+
+		constexpr uint64_t finalize(uint64_t h)
+		{
+			return ((h ^ (h >> r)) * m) ^ (((h ^ (h >> r)) * m) >> r);
+		}
+
+		constexpr uint32_t length(const char* key, uint32_t idx)
+		{
+			return key[idx] == '\0' ? idx : length(key, idx + 1);
+		}
+	}
+
+	constexpr uint64_t murmur_hash_64_constexpr(const char* key, uint32_t len, uint32_t seed)
+	{
+		return constexpr_murmur::finalize(constexpr_murmur::tail(key, len & ~7u, len & 7, constexpr_murmur::body(key, 0, len / 8, seed ^ (len * constexpr_murmur::m))));
+	}
+
+	constexpr uint64_t murmur_hash_64_constexpr(const char* key, uint32_t seed)
+	{
+		return murmur_hash_64_constexpr(key, constexpr_murmur::length(key, 0), seed);
+	}
+
+	// 128 bit hash value
+	struct Hash128
+	{
+		uint64_t low;
+		uint64_t high;
+	};
+
+	// Fast non cryptographic hash (wyhash final version), keys of up to 16 bytes take a branch light path.
+	// The values differ from murmur_hash_64, they are not meant to replace persisted ids.
+	uint64_t fast_hash_64(const void * key, uint64_t len, uint64_t seed);
+	Hash128 fast_hash_128(const void * key, uint64_t len, uint64_t seed);
+
+	// Sizes of the streaming hasher buffers
+	const uint32_t FAST_HASH_BLOCK_SIZE = 48;
+	const uint32_t FAST_HASH_HISTORY_SIZE = 16;
+
+	// Streaming version of fast_hash_64/fast_hash_128, the digest does not depend on how the input is split
+	class FastHasher
+	{
+	public:
+		// Cst
+		FastHasher(uint64_t seed);
+
+		// Restart with a new seed
+		void init(uint64_t seed);
+
+		// Hash the next piece of the input
+		void update(const void* data, uint64_t size);
+
+		// Digest of the input so far (more data can still be appended after)
+		uint64_t finalize() const;
+		Hash128 finalize_128() const;
+
+	private:
+		void state(uint64_t& a, uint64_t& b) const;
+
+	private:
+		uint64_t _seed;
+		uint64_t _see1;
+		uint64_t _see2;
+		uint64_t _length;
+		// Last bytes of the previous block followed by the pending ones (at most one block)
+		unsigned char _buffer[FAST_HASH_HISTORY_SIZE + FAST_HASH_BLOCK_SIZE];
+		uint32_t _pending;
+	};
 }
\ No newline at end of file
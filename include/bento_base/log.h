@@ -1,5 +1,17 @@
 #pragma once
 
+// External includes
+#include <stdint.h>
+
+// Compile-time floor of the log levels, the bento_log_* macros below it compile to nothing (debug is only kept in debug builds)
+#if !defined(BENTO_LOG_MIN_LEVEL)
+	#if defined(NDEBUG)
+		#define BENTO_LOG_MIN_LEVEL 1
+	#else
+		#define BENTO_LOG_MIN_LEVEL 0
+	#endif
+#endif
+
 namespace bento {
 	// The different log levels that are supported
 	namespace LogLevel {
@@ -25,10 +37,59 @@ namespace bento {
 
 		// Insert empty new line
 		virtual void new_line() = 0;
+
+		// Make sure everything that was logged has been written (for buffered loggers)
+		virtual void flush() {}
 	};
 
 	// default logger manipulation
 	ILogger* default_logger();
 	void set_default_logger(ILogger* _loggerInterface);
 	void reset_logger();
-}
\ No newline at end of file
+
+	// Runtime filtering, messages below the minimal level are discarded
+	void set_min_log_level(LogLevel::Type log_level);
+	LogLevel::Type min_log_level();
+	bool log_enabled(LogLevel::Type log_level);
+
+	// Token bucket rate limit of a tag: messages_per_second are refilled up to burst (0 messages_per_second disables the limit).
+	// The tags without a limit of their own use the default one, which is unlimited until set.
+	void set_log_rate_limit(const char* tag, uint32_t messages_per_second, uint32_t burst);
+	void set_default_log_rate_limit(uint32_t messages_per_second, uint32_t burst);
+
+	// Logger that receives every message given to log_message before the level filters and the rate limits
+	// (log_enabled is always true while one is set, the compile-time floor still applies), nullptr to remove it
+	void set_log_recorder(ILogger* recorder);
+	ILogger* log_recorder();
+
+	// Filter, rate limit and forward a message to the default logger.
+	// The suppressed messages are reported ("N messages suppressed") by the first message of any tag logged once their tag
+	// refilled a token.
+	void log_message(LogLevel::Type log_level, const char* tag, const char* message);
+
+	// Report the messages suppressed so far for every tag
+	void report_suppressed_logs();
+}
+
+// Logging macros, the message is only evaluated if the level passes the filters
+#define bento_log(LEVEL, TAG, MESSAGE) do { if (bento::log_enabled(LEVEL)) bento::log_message(LEVEL, TAG, MESSAGE); } while (0)
+
+#if BENTO_LOG_MIN_LEVEL <= 0
+	#define bento_log_debug(TAG, MESSAGE) bento_log(bento::LogLevel::debug, TAG, MESSAGE)
+#else
+	#define bento_log_debug(TAG, MESSAGE) do {} while (0)
+#endif
+
+#if BENTO_LOG_MIN_LEVEL <= 1
+	#define bento_log_info(TAG, MESSAGE) bento_log(bento::LogLevel::info, TAG, MESSAGE)
+#else
+	#define bento_log_info(TAG, MESSAGE) do {} while (0)
+#endif
+
+#if BENTO_LOG_MIN_LEVEL <= 2
+	#define bento_log_warning(TAG, MESSAGE) bento_log(bento::LogLevel::warning, TAG, MESSAGE)
+#else
+	#define bento_log_warning(TAG, MESSAGE) do {} while (0)
+#endif
+
+#define bento_log_error(TAG, MESSAGE) bento_log(bento::LogLevel::error, TAG, MESSAGE)
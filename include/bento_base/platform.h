@@ -15,6 +15,7 @@
 
     // Defines
     #define FUNCTION_NAME __PRETTY_FUNCTION__
+    #define bento_forceinline inline __attribute__((always_inline))
     #define EXCEPTION_STACK_SIZE 20
     #define SLEEP_FUNCTION(time) sleep(time * 0.001)
 
@@ -35,6 +36,23 @@
         free(ptr);
     }
 
+    // Index of the lowest set bit (the value must not be 0)
+    inline uint32_t first_bit_set(uint32_t value)
+    {
+        return (uint32_t)__builtin_ctz(value);
+    }
+
+    inline uint32_t first_bit_set(uint64_t value)
+    {
+        return (uint32_t)__builtin_ctzll(value);
+    }
+
+    // Number of set bits
+    inline uint32_t count_bits(uint64_t value)
+    {
+        return (uint32_t)__builtin_popcountll(value);
+    }
+
 #elif defined(WINDOWSPC)
     // Includes
     #pragma warning(push)
@@ -43,6 +61,7 @@
     #pragma warning(pop)
     #include <stdint.h>
     #include <windows.h>
+    #include <intrin.h>
     #define SLEEP_FUNCTION(time) Sleep(time)
 
     inline void* platform_allocate(size_t size, size_t alignment)
@@ -54,12 +73,55 @@
     {
         _aligned_free(ptr);
     }
+
+    // Index of the lowest set bit (the value must not be 0)
+    inline uint32_t first_bit_set(uint32_t value)
+    {
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return (uint32_t)index;
+    }
+
+    inline uint32_t first_bit_set(uint64_t value)
+    {
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return (uint32_t)index;
+    }
+
+    // Is the popcnt instruction available (checked once with cpuid)
+    inline bool cpu_supports_popcnt()
+    {
+        static const bool has_popcnt = []()
+        {
+            int registers[4];
+            __cpuid(registers, 1);
+            return (registers[2] & (1 << 23)) != 0;
+        }();
+        return has_popcnt;
+    }
+
+    // Number of set bits (portable fallback on the CPUs without popcnt)
+    inline uint32_t count_bits(uint64_t value)
+    {
+        if (cpu_supports_popcnt())
+            return (uint32_t)__popcnt64(value);
+        value = value - ((value >> 1) & 0x5555555555555555ull);
+        value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+        value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return (uint32_t)((value * 0x0101010101010101ull) >> 56);
+    }
+
     // defines
+    #define bento_forceinline __forceinline
     #define FUNCTION_NAME __func__
 #else
     #error Unsupported platfrom
 #endif
 
+// Size of a cache line, used to keep data that is written by different threads apart
+#define CACHE_LINE_SIZE 64
+
 // To avoid collision with of the macros with the functions
 #undef min
 #undef max
\ No newline at end of file
@@ -4,6 +4,11 @@ namespace bento {
 	// Function that handles a fail
 	void __handle_fail(const char* msg, const char* file_name, int line);
 
+	// Called by __handle_fail after the failure was logged (before the program is stopped)
+	typedef void (*FailCallback)(const char* msg, const char* file_name, int line);
+	void set_fail_callback(FailCallback callback);
+	FailCallback fail_callback();
+
 	// Assert functions
 	#define assert_fail_msg(msg) bento::__handle_fail(msg, __FILE__, __LINE__)
 	#define assert_fail() assert_fail_msg("")
@@ -4,27 +4,172 @@
 #include "bento_collection/vector.h"
 
 namespace bento {
-	// Functions to pack/unpack a raw buffer (knwoing its size in both cases
+	// Functions to pack/unpack a raw buffer (knwoing its size in both cases), data that would overflow the buffer size is dropped
 	void pack_buffer(Vector<char>& buffer, uint32_t write_size, const char* data);
-	void unpack_buffer(const char*& stream, uint32_t read_size, char* data);
+	void pack_buffer(Vector64<char>& buffer, uint64_t write_size, const char* data);
+	void unpack_buffer(const char*& stream, uint64_t read_size, char* data);
+
+	// Functions to pack/unpack an element count. Counts are stored on 32 bits, larger ones are escaped
+	// with UINT32_MAX followed by the 64 bit count so that data written by older versions still reads.
+	// A count above max_count is an error, 0 is returned instead.
+	template<typename TSize>
+	void pack_count(Vector<char, TSize>& buffer, uint64_t count);
+	uint64_t unpack_count(const char*& stream, uint64_t max_count);
 
 	// Functions to pack/unpack a type T as bytes
-	template<typename T>
-	void pack_bytes(Vector<char>& buffer, const T& type);
+	template<typename T, typename TSize>
+	void pack_bytes(Vector<char, TSize>& buffer, const T& type);
 	template<typename T>
 	void unpack_bytes(const char*& stream, T& type);
 
 	// Functions to pack/unpack a vector and its elements as types
-	template<typename T>
-	void pack_vector_types(Vector<char>& buffer, const Vector<T>& data);
-	template<typename T>
-	void unpack_vector_types(const char*& stream, Vector<T>& data);
+	template<typename T, typename TBufferSize, typename TSize>
+	void pack_vector_types(Vector<char, TBufferSize>& buffer, const Vector<T, TSize>& data);
+	template<typename T, typename TSize>
+	void unpack_vector_types(const char*& stream, Vector<T, TSize>& data);
 
-	// Function to pack/unpack a buffer and its content as bytes
-	template<typename T>
-	void pack_vector_bytes(Vector<char>& buffer, const Vector<T>& data);
-	template<typename T>
-	void unpack_vector_bytes(const char*& stream, Vector<T>& data);
+	// Function to pack/unpack a buffer and its content as bytes, a vector larger than the buffer can hold is not packed
+	template<typename T, typename TBufferSize, typename TSize>
+	void pack_vector_bytes(Vector<char, TBufferSize>& buffer, const Vector<T, TSize>& data);
+	template<typename T, typename TSize>
+	void unpack_vector_bytes(const char*& stream, Vector<T, TSize>& data);
+
+	// Compact encodings of the integers, small values take less bytes
+	const uint32_t MAX_VARINT_SIZE = 10;
+
+	// Zigzag mapping of the signed values (small magnitudes become small unsigned values)
+	inline uint64_t zigzag_encode(int64_t value) { return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63); }
+	inline int64_t zigzag_decode(uint64_t value) { return (int64_t)(value >> 1) ^ -(int64_t)(value & 1); }
+
+	// Write a LEB128 varint (7 bits per byte) in output (MAX_VARINT_SIZE bytes at most), returns its size
+	uint32_t encode_varint(uint64_t value, char* output);
+
+	// Number of bits needed to store a value (0 for 0)
+	uint32_t bit_width(uint64_t max_value);
+
+	// Write/read values on num_bits bits each (up to 32), the (num_values * num_bits + 7) / 8 bytes are filled from the lowest bit
+	void encode_bits(const uint32_t* values, uint32_t num_values, uint32_t num_bits, char* output);
+	void decode_bits(const char* input, uint32_t num_values, uint32_t num_bits, uint32_t* values);
+
+	// Functions to pack/unpack an integer as a varint (zigzag encoded for the signed ones)
+	void pack_varint(Vector<char>& buffer, uint64_t value);
+	void pack_varint(Vector64<char>& buffer, uint64_t value);
+	uint64_t unpack_varint(const char*& stream);
+	void pack_signed_varint(Vector<char>& buffer, int64_t value);
+	void pack_signed_varint(Vector64<char>& buffer, int64_t value);
+	int64_t unpack_signed_varint(const char*& stream);
+
+	// Functions to pack/unpack a sorted (non decreasing) index array as the varint deltas between the indices
+	void pack_sorted_indices(Vector<char>& buffer, const uint32_t* indices, uint32_t num_indices);
+	void pack_sorted_indices(Vector64<char>& buffer, const uint32_t* indices, uint32_t num_indices);
+	void unpack_sorted_indices(const char*& stream, Vector<uint32_t>& indices);
+
+	// Functions to pack/unpack an array on the smallest number of bits that fits its largest value.
+	// An array of zeros takes no data, the unpacking rejects the arrays longer than max_values.
+	void pack_bit_packed(Vector<char>& buffer, const uint32_t* values, uint32_t num_values);
+	void pack_bit_packed(Vector64<char>& buffer, const uint32_t* values, uint32_t num_values);
+	void unpack_bit_packed(const char*& stream, Vector<uint32_t>& values, uint32_t max_values);
+
+	// Bounds checked reader over a memory buffer. A read past the end puts the reader in an error state,
+	// every read that follows fails (and zeroes its output) so the state can be checked once at the end.
+	class StreamReader
+	{
+	public:
+		// Cst
+		StreamReader(const char* data, uint64_t size);
+		StreamReader(const char* begin, const char* end);
+
+		// Reader without an end for the unpack functions, they trust the data so only the format is validated
+		static StreamReader unbounded(const char* data);
+
+		// Copy the next size bytes
+		bool read(char* data, uint64_t size);
+
+		// Pointer on the next size bytes of the source buffer (nullptr if there are not enough), nothing is copied
+		const char* read_view(uint64_t size);
+
+		// Skip the next size bytes
+		bool skip(uint64_t size);
+
+		// Same layouts as unpack_bytes, unpack_count and unpack_vector_bytes
+		template<typename T>
+		bool read_bytes(T& type);
+		uint64_t read_count(uint64_t max_count);
+		template<typename T, typename TSize>
+		bool read_vector_bytes(Vector<T, TSize>& data);
+
+		// Same layouts as unpack_varint, unpack_signed_varint, unpack_sorted_indices and unpack_bit_packed
+		uint64_t read_varint();
+		int64_t read_signed_varint();
+		bool read_sorted_indices(Vector<uint32_t>& indices);
+		bool read_bit_packed(Vector<uint32_t>& values, uint32_t max_values);
+
+		// Flag the data as corrupted (for the validations done by the caller)
+		void fail();
+
+		// State
+		inline bool failed() const { return _failed; }
+		inline bool at_end() const { return _cursor == _end; }
+		inline uint64_t remaining() const { return _end != nullptr ? (uint64_t)(_end - _cursor) : UINT64_MAX; }
+		inline uint64_t position() const { return (uint64_t)(_cursor - _begin); }
+		inline const char* cursor() const { return _cursor; }
+
+	private:
+		const char* _begin;
+		const char* _cursor;
+		// nullptr for the unbounded readers
+		const char* _end;
+		bool _failed;
+	};
+
+	// Appends to a byte buffer with a geometric growth, space can be reserved ahead and filled in place
+	class StreamWriter
+	{
+	public:
+		// Cst, the writes are appended to the content of the buffer
+		StreamWriter(Vector<char>& buffer);
+
+		// Make sure the next size bytes can be written without reallocating
+		void reserve(uint32_t size);
+
+		// Append size bytes
+		void write(const char* data, uint32_t size);
+
+		// Append size uninitialized bytes and return a pointer on them (fatal if the buffer would go past 4GB)
+		inline char* write_view(uint32_t size)
+		{
+			uint32_t old_size = _buffer.size();
+			if (size > UINT32_MAX - old_size)
+			{
+				assert_fail_msg("The stream does not fit in a 32 bit buffer");
+				abort();
+			}
+			if (old_size + size > _buffer.capacity())
+				reserve(size);
+			_buffer.resize(old_size + size);
+			return _buffer.begin() + old_size;
+		}
+
+		// Same layouts as pack_bytes, pack_count and pack_vector_bytes
+		template<typename T>
+		void write_bytes(const T& type);
+		void write_count(uint64_t count);
+		template<typename T, typename TSize>
+		void write_vector_bytes(const Vector<T, TSize>& data);
+
+		// Same layouts as pack_varint, pack_signed_varint, pack_sorted_indices and pack_bit_packed
+		void write_varint(uint64_t value);
+		inline void write_signed_varint(int64_t value) { write_varint(zigzag_encode(value)); }
+		void write_sorted_indices(const uint32_t* indices, uint32_t num_indices);
+		void write_bit_packed(const uint32_t* values, uint32_t num_values);
+
+		// Accessors
+		inline uint32_t size() const { return _buffer.size(); }
+		inline Vector<char>& buffer() { return _buffer; }
+
+	private:
+		Vector<char>& _buffer;
+	};
 }
 
-#include "stream.inl"
\ No newline at end of file
+#include "stream.inl"
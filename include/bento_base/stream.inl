@@ -1,7 +1,22 @@
-
 namespace bento {
-	template<typename T>
-	void pack_bytes(Vector<char>& buffer, const T& type)
+	template<typename TSize>
+	void pack_count(Vector<char, TSize>& buffer, uint64_t count)
+	{
+		if (count < UINT32_MAX)
+		{
+			uint32_t short_count = (uint32_t)count;
+			pack_bytes(buffer, short_count);
+		}
+		else
+		{
+			uint32_t escape = UINT32_MAX;
+			pack_bytes(buffer, escape);
+			pack_bytes(buffer, count);
+		}
+	}
+
+	template<typename T, typename TSize>
+	void pack_bytes(Vector<char, TSize>& buffer, const T& type)
 	{
 		pack_buffer(buffer, (uint32_t)sizeof(T), (const char*)&type);
 	}
@@ -9,54 +24,97 @@ namespace bento {
 	template<typename T>
 	void unpack_bytes(const char*& stream, T& type)
 	{
-		unpack_buffer(stream, (uint32_t)sizeof(T), (char*)&type);
+		unpack_buffer(stream, sizeof(T), (char*)&type);
 	}
 
-	template<typename T>
-	void pack_vector_types(Vector<char>& buffer, const Vector<T>& data)
+	template<typename T, typename TBufferSize, typename TSize>
+	void pack_vector_types(Vector<char, TBufferSize>& buffer, const Vector<T, TSize>& data)
 	{
-		uint32_t num_elements = data.size();
-		pack_bytes(buffer, num_elements);
+		TSize num_elements = data.size();
+		pack_count(buffer, num_elements);
 		if (num_elements) {
-			for (uint32_t ele_idx = 0; ele_idx < num_elements; ++ele_idx)
+			for (TSize ele_idx = 0; ele_idx < num_elements; ++ele_idx)
 			{
 				pack_type(buffer, data[ele_idx]);
 			}
 		}
 	}
 
-	template<typename T>
-	void unpack_vector_types(const char*& stream, Vector<T>& data)
+	template<typename T, typename TSize>
+	void unpack_vector_types(const char*& stream, Vector<T, TSize>& data)
 	{
-		uint32_t num_elements;
-		unpack_bytes(stream, num_elements);
+		TSize num_elements = (TSize)unpack_count(stream, (TSize)~(TSize)0);
 		data.resize(num_elements);
 		if (num_elements) {
-			for (uint32_t ele_idx = 0; ele_idx < num_elements; ++ele_idx)
+			for (TSize ele_idx = 0; ele_idx < num_elements; ++ele_idx)
 			{
 				unpack_type(stream, data[ele_idx]);
 			}
 		}
 	}
 
-	template<typename T>
-	void pack_vector_bytes(Vector<char>& buffer, const Vector<T>& data)
+	template<typename T, typename TBufferSize, typename TSize>
+	void pack_vector_bytes(Vector<char, TBufferSize>& buffer, const Vector<T, TSize>& data)
 	{
-		uint32_t num_elements = data.size();
-		pack_bytes(buffer, num_elements);
+		// The byte size is computed on 64 bits, a 64 bit vector may not fit in a 32 bit buffer
+		TSize num_elements = data.size();
+		uint64_t data_size = (uint64_t)num_elements * sizeof(T);
+		if (data_size > (uint64_t)(TBufferSize)~(TBufferSize)0)
+		{
+			assert_fail_msg("The vector does not fit in the buffer");
+			return;
+		}
+		pack_count(buffer, num_elements);
 		if (num_elements) {
-			pack_buffer(buffer, num_elements * (uint32_t)sizeof(T), (const char*)data.begin());
+			pack_buffer(buffer, (TBufferSize)data_size, (const char*)data.begin());
 		}
 	}
 
-	template<typename T>
-	void unpack_vector_bytes(const char*& stream, Vector<T>& data)
+	template<typename T, typename TSize>
+	void unpack_vector_bytes(const char*& stream, Vector<T, TSize>& data)
 	{
-		uint32_t num_elements;
-		unpack_bytes(stream, num_elements);
+		TSize num_elements = (TSize)unpack_count(stream, (TSize)~(TSize)0);
 		data.resize(num_elements);
 		if (num_elements) {
-			unpack_buffer(stream, num_elements * (uint32_t)sizeof(T), (char*)data.begin());
+			unpack_buffer(stream, (uint64_t)num_elements * sizeof(T), (char*)data.begin());
 		}
 	}
-}
\ No newline at end of file
+
+	template<typename T>
+	bool StreamReader::read_bytes(T& type)
+	{
+		return read((char*)&type, sizeof(T));
+	}
+
+	template<typename T, typename TSize>
+	bool StreamReader::read_vector_bytes(Vector<T, TSize>& data)
+	{
+		// The count is validated against the remaining bytes before anything is allocated
+		uint64_t num_elements = read_count((TSize)~(TSize)0);
+		if (num_elements > remaining() / sizeof(T))
+		{
+			fail();
+			data.resize(0);
+			return false;
+		}
+		data.resize((TSize)num_elements);
+		if (num_elements)
+			read((char*)data.begin(), num_elements * sizeof(T));
+		return !_failed;
+	}
+
+	template<typename T>
+	void StreamWriter::write_bytes(const T& type)
+	{
+		memcpy(write_view((uint32_t)sizeof(T)), &type, sizeof(T));
+	}
+
+	template<typename T, typename TSize>
+	void StreamWriter::write_vector_bytes(const Vector<T, TSize>& data)
+	{
+		uint32_t data_size = (uint32_t)(data.size() * sizeof(T));
+		reserve(2 * sizeof(uint64_t) + data_size);
+		write_count(data.size());
+		write((const char*)data.begin(), data_size);
+	}
+}
@@ -4,6 +4,9 @@
 #include "log.h"
 
 namespace bento {
+	// Prefix of a log level ("[ERROR]" for instance)
+	const char* level_to_string(LogLevel::Type log_level);
+
 	// Lgger that logs through the standard output
 	class SystemLogger : public ILogger
 	{
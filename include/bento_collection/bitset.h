@@ -0,0 +1,121 @@
+#pragma once
+
+// Library includes
+#include "bento_collection/vector.h"
+
+namespace bento {
+
+	// Word level operations shared by the bit containers (the bulk ones are vectorized when possible)
+	namespace bit_array
+	{
+		// target = target & source
+		void and_words(uint64_t* target, const uint64_t* source, uint32_t num_words);
+
+		// target = target | source
+		void or_words(uint64_t* target, const uint64_t* source, uint32_t num_words);
+
+		// target = target & ~source
+		void and_not_words(uint64_t* target, const uint64_t* source, uint32_t num_words);
+
+		// Number of set bits
+		uint32_t count_bits(const uint64_t* words, uint32_t num_words);
+
+		// Index of the first set bit at or after first_bit (UINT32_MAX if there is none)
+		uint32_t find_next_set(const uint64_t* words, uint32_t num_words, uint32_t first_bit);
+
+		// Call a functor with the index of every set bit
+		template<typename Functor>
+		void for_each_set_bit(const uint64_t* words, uint32_t num_words, Functor functor);
+	}
+
+	// Fixed size set of bits
+	template<uint32_t N>
+	class Bitset
+	{
+	public:
+		// Cst (all the bits are cleared)
+		Bitset();
+
+		// Single bit manipulation
+		inline void set(uint32_t bit_idx) { _words[bit_idx / 64] |= (uint64_t)1 << (bit_idx % 64); }
+		inline void reset(uint32_t bit_idx) { _words[bit_idx / 64] &= ~((uint64_t)1 << (bit_idx % 64)); }
+		inline bool test(uint32_t bit_idx) const { return (_words[bit_idx / 64] & ((uint64_t)1 << (bit_idx % 64))) != 0; }
+
+		// Whole set manipulation
+		void set_all();
+		void clear_all();
+
+		// Queries
+		inline uint32_t size() const { return N; }
+		uint32_t count() const;
+		bool any() const;
+		uint32_t find_first_set() const;
+		uint32_t find_next_set(uint32_t first_bit) const;
+
+		// Bulk operations
+		Bitset& operator&=(const Bitset& bitset);
+		Bitset& operator|=(const Bitset& bitset);
+		Bitset& and_not(const Bitset& bitset);
+
+		// Call a functor with the index of every set bit
+		template<typename Functor>
+		void for_each_set_bit(Functor functor) const;
+
+		// Raw access to the words
+		static const uint32_t num_words = (N + 63) / 64;
+		inline uint64_t* words() { return _words; }
+		inline const uint64_t* words() const { return _words; }
+
+	private:
+		uint64_t _words[num_words];
+	};
+
+	// Dynamically sized set of bits
+	class BitVector
+	{
+	public:
+		ALLOCATOR_BASED;
+		// Cst
+		BitVector(IAllocator& allocator);
+		BitVector(IAllocator& allocator, uint32_t num_bits);
+
+		// Resize the set (the new bits are cleared)
+		void resize(uint32_t num_bits);
+
+		// Single bit manipulation
+		inline void set(uint32_t bit_idx) { _words[bit_idx / 64] |= (uint64_t)1 << (bit_idx % 64); }
+		inline void reset(uint32_t bit_idx) { _words[bit_idx / 64] &= ~((uint64_t)1 << (bit_idx % 64)); }
+		inline bool test(uint32_t bit_idx) const { return (_words[bit_idx / 64] & ((uint64_t)1 << (bit_idx % 64))) != 0; }
+
+		// Whole set manipulation
+		void set_all();
+		void clear_all();
+
+		// Queries
+		inline uint32_t size() const { return _num_bits; }
+		uint32_t count() const;
+		bool any() const;
+		uint32_t find_first_set() const;
+		uint32_t find_next_set(uint32_t first_bit) const;
+
+		// Bulk operations (both sets must have the same size)
+		BitVector& operator&=(const BitVector& bit_vector);
+		BitVector& operator|=(const BitVector& bit_vector);
+		BitVector& and_not(const BitVector& bit_vector);
+
+		// Call a functor with the index of every set bit
+		template<typename Functor>
+		void for_each_set_bit(Functor functor) const;
+
+		// Raw access to the words
+		inline uint32_t num_words() const { return _words.size(); }
+		inline uint64_t* words() { return _words.begin(); }
+		inline const uint64_t* words() const { return _words.begin(); }
+
+	private:
+		Vector<uint64_t> _words;
+		uint32_t _num_bits;
+	};
+}
+
+#include "bitset.inl"
@@ -0,0 +1,101 @@
+
+namespace bento
+{
+	namespace bit_array
+	{
+		template<typename Functor>
+		void for_each_set_bit(const uint64_t* words, uint32_t num_words, Functor functor)
+		{
+			for (uint32_t word_idx = 0; word_idx < num_words; ++word_idx)
+			{
+				// Pop the set bits one by one
+				uint64_t word = words[word_idx];
+				while (word != 0)
+				{
+					functor(word_idx * 64 + first_bit_set(word));
+					word &= word - 1;
+				}
+			}
+		}
+	}
+
+	template<uint32_t N>
+	Bitset<N>::Bitset()
+	{
+		clear_all();
+	}
+
+	template<uint32_t N>
+	void Bitset<N>::set_all()
+	{
+		memset(_words, 0xFF, sizeof(_words));
+
+		// The bits past N stay cleared
+		if (N % 64)
+			_words[num_words - 1] = ((uint64_t)1 << (N % 64)) - 1;
+	}
+
+	template<uint32_t N>
+	void Bitset<N>::clear_all()
+	{
+		memset(_words, 0, sizeof(_words));
+	}
+
+	template<uint32_t N>
+	uint32_t Bitset<N>::count() const
+	{
+		return bit_array::count_bits(_words, num_words);
+	}
+
+	template<uint32_t N>
+	bool Bitset<N>::any() const
+	{
+		return find_first_set() != UINT32_MAX;
+	}
+
+	template<uint32_t N>
+	uint32_t Bitset<N>::find_first_set() const
+	{
+		return bit_array::find_next_set(_words, num_words, 0);
+	}
+
+	template<uint32_t N>
+	uint32_t Bitset<N>::find_next_set(uint32_t first_bit) const
+	{
+		return bit_array::find_next_set(_words, num_words, first_bit);
+	}
+
+	template<uint32_t N>
+	Bitset<N>& Bitset<N>::operator&=(const Bitset<N>& bitset)
+	{
+		bit_array::and_words(_words, bitset._words, num_words);
+		return *this;
+	}
+
+	template<uint32_t N>
+	Bitset<N>& Bitset<N>::operator|=(const Bitset<N>& bitset)
+	{
+		bit_array::or_words(_words, bitset._words, num_words);
+		return *this;
+	}
+
+	template<uint32_t N>
+	Bitset<N>& Bitset<N>::and_not(const Bitset<N>& bitset)
+	{
+		bit_array::and_not_words(_words, bitset._words, num_words);
+		return *this;
+	}
+
+	template<uint32_t N>
+	template<typename Functor>
+	void Bitset<N>::for_each_set_bit(Functor functor) const
+	{
+		bit_array::for_each_set_bit(_words, num_words, functor);
+	}
+
+	template<typename Functor>
+	void BitVector::for_each_set_bit(Functor functor) const
+	{
+		bit_array::for_each_set_bit(_words.begin(), _words.size(), functor);
+	}
+}
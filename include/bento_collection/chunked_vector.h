@@ -0,0 +1,74 @@
+#pragma once
+
+// Library includes
+#include "bento_collection/vector.h"
+
+namespace bento {
+
+	// Array that grows by adding fixed size chunks, the elements are never relocated.
+	// Pointers and references on the elements stay valid until they are removed, indexed access stays O(1).
+	template <typename T, uint32_t CHUNK_SIZE = 64>
+	class ChunkedVector
+	{
+	public:
+		ALLOCATOR_BASED;
+		static_assert((CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0, "The chunk size must be a power of two");
+
+		// Type definition
+		typedef T& reference;
+		typedef const T& const_reference;
+
+		// Cst & Dst
+		ChunkedVector(IAllocator& allocator);
+		~ChunkedVector();
+
+		// Accessors
+		inline uint32_t size() const { return _size; }
+		inline uint32_t capacity() const { return _chunks.size() * CHUNK_SIZE; }
+
+		inline reference operator[](uint32_t index)
+		{
+			return _chunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+		}
+
+		inline const_reference operator[](uint32_t index) const
+		{
+			return _chunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+		}
+
+		// Resize the array
+		void resize(uint32_t size);
+
+		// Append an element in the array
+		void push_back(const T& value);
+
+		// Creates a new element and returns a reference to it
+		reference extend();
+
+		// set the size to 0 (the chunks are kept)
+		void clear();
+
+		// Free the memory
+		void free();
+
+	private:
+		// Make sure the chunk of an index exists
+		void ensure_capacity(uint32_t size);
+
+		void construct(T* p, const Int2Type<true>&) { new (p) T(*_allocator); }
+		void construct(T* p, const Int2Type<false>&) { new (p) T(); }
+
+		// Forbidden, the elements can't be moved
+		ChunkedVector(const ChunkedVector&);
+		void operator=(const ChunkedVector&);
+
+	private:
+		Vector<T*> _chunks;
+		uint32_t _size;
+
+	public:
+		IAllocator* _allocator;
+	};
+}
+
+#include "chunked_vector.inl"
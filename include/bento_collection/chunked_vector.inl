@@ -0,0 +1,86 @@
+
+namespace bento
+{
+	template <typename T, uint32_t CHUNK_SIZE>
+	ChunkedVector<T, CHUNK_SIZE>::ChunkedVector(IAllocator& allocator)
+	: _chunks(allocator)
+	, _size(0)
+	, _allocator(&allocator)
+	{
+	}
+
+	template <typename T, uint32_t CHUNK_SIZE>
+	ChunkedVector<T, CHUNK_SIZE>::~ChunkedVector()
+	{
+		free();
+	}
+
+	template <typename T, uint32_t CHUNK_SIZE>
+	void ChunkedVector<T, CHUNK_SIZE>::ensure_capacity(uint32_t size)
+	{
+		// Only the chunk pointer table is reallocated, never the elements
+		while (capacity() < size)
+		{
+			T* chunk = (T*)_allocator->allocate(sizeof(T) * CHUNK_SIZE, alignof(T) > 4 ? alignof(T) : 4);
+			_chunks.push_back(chunk);
+		}
+	}
+
+	template <typename T, uint32_t CHUNK_SIZE>
+	void ChunkedVector<T, CHUNK_SIZE>::resize(uint32_t size)
+	{
+		if (size < _size)
+		{
+			if (!std::is_trivially_destructible<T>())
+			{
+				for (uint32_t ele_idx = size; ele_idx < _size; ++ele_idx)
+				{
+					(*this)[ele_idx].~T();
+				}
+			}
+		}
+		else
+		{
+			ensure_capacity(size);
+			for (uint32_t ele_idx = _size; ele_idx < size; ++ele_idx)
+			{
+				construct(&(*this)[ele_idx], IS_ALLOCATOR_BASED_TYPE(T)());
+			}
+		}
+		_size = size;
+	}
+
+	template <typename T, uint32_t CHUNK_SIZE>
+	void ChunkedVector<T, CHUNK_SIZE>::push_back(const T& value)
+	{
+		extend() = value;
+	}
+
+	template <typename T, uint32_t CHUNK_SIZE>
+	T& ChunkedVector<T, CHUNK_SIZE>::extend()
+	{
+		ensure_capacity(_size + 1);
+		T* element = &(*this)[_size];
+		construct(element, IS_ALLOCATOR_BASED_TYPE(T)());
+		_size++;
+		return *element;
+	}
+
+	template <typename T, uint32_t CHUNK_SIZE>
+	void ChunkedVector<T, CHUNK_SIZE>::clear()
+	{
+		resize(0);
+	}
+
+	template <typename T, uint32_t CHUNK_SIZE>
+	void ChunkedVector<T, CHUNK_SIZE>::free()
+	{
+		clear();
+		uint32_t num_chunks = _chunks.size();
+		for (uint32_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx)
+		{
+			_allocator->deallocate(_chunks[chunk_idx]);
+		}
+		_chunks.free();
+	}
+}
@@ -2,6 +2,7 @@
 
 // Library includes
 #include "bento_collection/vector.h"
+#include "bento_collection/string_view.h"
 #include "bento_base/platform.h"
 
 namespace bento {
@@ -14,19 +15,28 @@ namespace bento {
 		DynamicString(IAllocator& allocator);
 		DynamicString(IAllocator& allocator, const char* str);
 		DynamicString(IAllocator& allocator, uint32_t str_size);
+		DynamicString(IAllocator& allocator, const StringView& str);
 		DynamicString(const DynamicString& str);
 
 		inline char* c_str() { return _data.size() ? _data.begin() : nullptr; }
 		inline const char* c_str() const { return _data.size() ? _data.begin() : ""; }
 
+		// Non-owning view on the content of the string
+		inline StringView view() const { return StringView(c_str(), size()); }
+
 		void resize(uint32_t size);
 		uint32_t size() const;
 		DynamicString& operator=(const DynamicString& str);
 		DynamicString& operator=(const char* str);
+		DynamicString& operator=(const StringView& str);
 		DynamicString& operator+=(const char* str);
 		DynamicString& operator+=(const DynamicString& str);
 		bool operator==(const char* str) const;
 		bool operator!=(const char* str) const;
+		bool operator==(const StringView& str) const;
+		bool operator!=(const StringView& str) const;
+		bool operator==(const DynamicString& str) const;
+		bool operator!=(const DynamicString& str) const;
 		void append(const char* str, uint32_t sizeP);
 
 	public:
@@ -34,20 +44,47 @@ namespace bento {
 		IAllocator& _allocator;
 	};
 
+	// View on a string with its hash cached, used as a map key the hashes are compared before the characters
+	struct StringKey
+	{
+		StringView str;
+		uint64_t hash;
+
+		inline bool operator==(const StringKey& key) const { return hash == key.hash && str == key.str; }
+		inline bool operator!=(const StringKey& key) const { return !((*this) == key); }
+	};
+
 	namespace string
 	{
 		// returns the length nof a string
 		uint32_t strlen32(const char* str);
 
-		// Find the last occurent of a character
+		// Find the last occurent of a character (returns the size of the string if not found)
 		uint32_t find_last_of(const char* str, const char s);
+		uint32_t find_last_of(const StringView& str, const char s);
 
-		// Put all the characters of a string to the lower case
+		// Put all the (ascii) characters of a string to the lower case
 		void to_lower_case(DynamicString& target_string);
+		void to_lower_case(char* str, uint32_t str_size);
+
+		// Compare two strings ignoring the case of the (ascii) characters
+		bool equals_ignore_case(const StringView& str0, const StringView& str1);
+
+		// Hash of a string ignoring the case of the (ascii) characters
+		uint64_t hash_ignore_case(const StringView& str);
+
+		// Build a key that carries its hash for cheap comparisons
+		StringKey make_key(const StringView& str);
 
 		// Get a substric from an original string
 		DynamicString substr(const DynamicString& source_string, uint32_t first_idx, uint32_t size);
 
+		// Get a view on a substring of an original string (no allocation)
+		StringView substr(const StringView& source_string, uint32_t first_idx, uint32_t size);
+
+		// Find the first occurence of a given string at or after start_idx (returns UINT32_MAX if there is none)
+		uint32_t find(const char* source_str, uint32_t source_str_size, const char* to_find, uint32_t to_find_size, uint32_t start_idx);
+
 		// Find all occurences of a given string into a bigger tring
 		void find_all_occurences(const char* source_str, uint32_t source_str_size, const char* to_find, uint32_t to_find_size, Vector<uint32_t>& results);
 
@@ -56,5 +93,6 @@ namespace bento {
 	}
 
 	void pack_type(Vector<char>& buffer, const DynamicString& str);
+	void pack_type(Vector64<char>& buffer, const DynamicString& str);
 	void unpack_type(const char*& stream, DynamicString& str);
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 
+// Library includes
+#include "bento_base/platform.h"
+
 namespace bento {
 
 	// Structure that handles a set of flags and allows to enable/access/reset
@@ -12,24 +15,24 @@ namespace bento {
 	template<typename Container, typename EnumSet>
 	bool has_flag(const FlagCarrier<Container, EnumSet>& fc, EnumSet flag)
 	{
-		return (fc._data & flag) != 0;
+		return (fc._data & (Container)flag) != 0;
 	}
 
 	template<typename Container, typename EnumSet>
-	__forceinline void reset_flag(const FlagCarrier<Container, EnumSet>& fc, EnumSet flag)
+	bento_forceinline void reset_flag(FlagCarrier<Container, EnumSet>& fc, EnumSet flag)
 	{
-		fc._data |= flag;
+		fc._data &= ~(Container)flag;
 	}
 
 	template<typename Container, typename EnumSet>
-	__forceinline void reset(const FlagCarrier<Container, EnumSet>& fc)
+	bento_forceinline void reset(FlagCarrier<Container, EnumSet>& fc)
 	{
-		fc._data  = EnumSet::EMPTY;
+		fc._data = (Container)EnumSet::EMPTY;
 	}
 
 	template<typename Container, typename EnumSet>
-	__forceinline void set_flag(const FlagCarrier<Container, EnumSet>& fc, EnumSet flag)
+	bento_forceinline void set_flag(FlagCarrier<Container, EnumSet>& fc, EnumSet flag)
 	{
-		fc._data &= ~(flag);
+		fc._data |= (Container)flag;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+// Library includes
+#include "bento_collection/flat_set.h"
+
+namespace bento {
+
+	// Associative container that stores its keys sorted in a contiguous array and its values in a parallel one.
+	// Lookups are binary searches on the key array, a good fit for tables that are built once and read often.
+	template <typename K, typename V>
+	class FlatMap
+	{
+	public:
+		ALLOCATOR_BASED;
+
+		// Cst
+		FlatMap(IAllocator& allocator);
+
+		// Accessors
+		inline uint32_t size() const { return _keys.size(); }
+		inline const K& key_at(uint32_t index) const { return _keys[index]; }
+		inline V& value_at(uint32_t index) { return _values[index]; }
+		inline const V& value_at(uint32_t index) const { return _values[index]; }
+		inline const Vector<K>& keys() const { return _keys; }
+		inline const Vector<V>& values() const { return _values; }
+
+		// Insert a pair, returns false and leaves the map untouched if the key is already present
+		bool insert(const K& key, const V& value);
+
+		// Insert a pair or overwrite the value of an existing key
+		void assign(const K& key, const V& value);
+
+		// Remove a key, returns false if it was not in the map
+		bool remove(const K& key);
+
+		// Value attached to a key (nullptr if the key is not in the map)
+		V* find(const K& key);
+		const V* find(const K& key) const;
+
+		// Is the key in the map
+		bool contains(const K& key) const;
+
+		// Index of the key in the map (UINT32_MAX if it is not in the map)
+		uint32_t index_of(const K& key) const;
+
+		// Replace the content of the map with unsorted pairs, the first occurrence of a duplicated key is kept
+		void build(const K* keys, const V* values, uint32_t num_pairs);
+
+		// Insert all the pairs of an other map, the values of this map win on duplicated keys
+		void merge(const FlatMap<K, V>& map);
+
+		// set the size to 0
+		void clear();
+
+	private:
+		Vector<K> _keys;
+		Vector<V> _values;
+
+		template <typename K2, typename V2>
+		friend void unpack_type(const char*& stream, FlatMap<K2, V2>& map);
+	};
+
+	// The keys and values are serialized as bytes, keys that are not sorted are sorted again at unpack time.
+	// Mismatching key and value counts are an error, the map is left empty.
+	template <typename K, typename V, typename TBufferSize>
+	void pack_type(Vector<char, TBufferSize>& buffer, const FlatMap<K, V>& map);
+	template <typename K, typename V>
+	void unpack_type(const char*& stream, FlatMap<K, V>& map);
+}
+
+#include "flat_map.inl"
@@ -0,0 +1,205 @@
+// External includes
+#include <algorithm>
+
+namespace bento
+{
+	template <typename K>
+	struct FlatMapIndexSorter
+	{
+		FlatMapIndexSorter(const K* keys)
+		: _keys(keys)
+		{
+		}
+
+		bool operator()(uint32_t a, uint32_t b) const
+		{
+			return _keys[a] < _keys[b];
+		}
+
+		const K* _keys;
+	};
+
+	template <typename K, typename V>
+	FlatMap<K, V>::FlatMap(IAllocator& allocator)
+	: _keys(allocator)
+	, _values(allocator)
+	{
+	}
+
+	template <typename K, typename V>
+	bool FlatMap<K, V>::insert(const K& key, const V& value)
+	{
+		uint32_t num_keys = _keys.size();
+		uint32_t position = flat::lower_bound(_keys.begin(), num_keys, key);
+		if (position < num_keys && !(key < _keys[position]))
+			return false;
+
+		// Shift the greater pairs to make room for the new one
+		_keys.resize(num_keys + 1);
+		_values.resize(num_keys + 1);
+		for (uint32_t pair_idx = num_keys; pair_idx > position; --pair_idx)
+		{
+			_keys[pair_idx] = _keys[pair_idx - 1];
+			_values[pair_idx] = _values[pair_idx - 1];
+		}
+		_keys[position] = key;
+		_values[position] = value;
+		return true;
+	}
+
+	template <typename K, typename V>
+	void FlatMap<K, V>::assign(const K& key, const V& value)
+	{
+		V* target = find(key);
+		if (target != nullptr)
+			*target = value;
+		else
+			insert(key, value);
+	}
+
+	template <typename K, typename V>
+	bool FlatMap<K, V>::remove(const K& key)
+	{
+		uint32_t position = index_of(key);
+		if (position == UINT32_MAX)
+			return false;
+
+		uint32_t num_keys = _keys.size();
+		for (uint32_t pair_idx = position + 1; pair_idx < num_keys; ++pair_idx)
+		{
+			_keys[pair_idx - 1] = _keys[pair_idx];
+			_values[pair_idx - 1] = _values[pair_idx];
+		}
+		_keys.resize(num_keys - 1);
+		_values.resize(num_keys - 1);
+		return true;
+	}
+
+	template <typename K, typename V>
+	uint32_t FlatMap<K, V>::index_of(const K& key) const
+	{
+		uint32_t num_keys = _keys.size();
+		uint32_t position = flat::lower_bound(_keys.begin(), num_keys, key);
+		return (position < num_keys && !(key < _keys[position])) ? position : UINT32_MAX;
+	}
+
+	template <typename K, typename V>
+	V* FlatMap<K, V>::find(const K& key)
+	{
+		uint32_t position = index_of(key);
+		return position != UINT32_MAX ? &_values[position] : nullptr;
+	}
+
+	template <typename K, typename V>
+	const V* FlatMap<K, V>::find(const K& key) const
+	{
+		uint32_t position = index_of(key);
+		return position != UINT32_MAX ? &_values[position] : nullptr;
+	}
+
+	template <typename K, typename V>
+	bool FlatMap<K, V>::contains(const K& key) const
+	{
+		return index_of(key) != UINT32_MAX;
+	}
+
+	template <typename K, typename V>
+	void FlatMap<K, V>::build(const K* keys, const V* values, uint32_t num_pairs)
+	{
+		// Sort the pair indices once, the stable sort keeps the first occurrence of a key in front
+		Vector<uint32_t> order(*_keys._allocator, num_pairs);
+		for (uint32_t pair_idx = 0; pair_idx < num_pairs; ++pair_idx)
+			order[pair_idx] = pair_idx;
+		std::stable_sort(order.begin(), order.end(), FlatMapIndexSorter<K>(keys));
+
+		// Gather the pairs and drop the duplicates
+		_keys.resize(num_pairs);
+		_values.resize(num_pairs);
+		uint32_t num_unique = 0;
+		for (uint32_t pair_idx = 0; pair_idx < num_pairs; ++pair_idx)
+		{
+			const K& key = keys[order[pair_idx]];
+			if (num_unique > 0 && !(_keys[num_unique - 1] < key))
+				continue;
+			_keys[num_unique] = key;
+			_values[num_unique] = values[order[pair_idx]];
+			++num_unique;
+		}
+		_keys.resize(num_unique);
+		_values.resize(num_unique);
+	}
+
+	template <typename K, typename V>
+	void FlatMap<K, V>::merge(const FlatMap<K, V>& map)
+	{
+		uint32_t num_keys = _keys.size();
+		uint32_t num_other_keys = map._keys.size();
+		if (num_other_keys == 0)
+			return;
+
+		// Linear merge of the two sorted arrays
+		Vector<K> merged_keys(*_keys._allocator);
+		Vector<V> merged_values(*_values._allocator);
+		merged_keys.reserve(num_keys + num_other_keys);
+		merged_values.reserve(num_keys + num_other_keys);
+		uint32_t pair_idx = 0, other_idx = 0;
+		while (pair_idx < num_keys || other_idx < num_other_keys)
+		{
+			bool take_self = other_idx == num_other_keys || (pair_idx < num_keys && !(map._keys[other_idx] < _keys[pair_idx]));
+			if (take_self)
+			{
+				// Skip the pair of the other map if it has the same key
+				if (other_idx < num_other_keys && !(_keys[pair_idx] < map._keys[other_idx]))
+					++other_idx;
+				merged_keys.push_back(_keys[pair_idx]);
+				merged_values.push_back(_values[pair_idx]);
+				++pair_idx;
+			}
+			else
+			{
+				merged_keys.push_back(map._keys[other_idx]);
+				merged_values.push_back(map._values[other_idx]);
+				++other_idx;
+			}
+		}
+		_keys = merged_keys;
+		_values = merged_values;
+	}
+
+	template <typename K, typename V>
+	void FlatMap<K, V>::clear()
+	{
+		_keys.clear();
+		_values.clear();
+	}
+
+	template <typename K, typename V, typename TBufferSize>
+	void pack_type(Vector<char, TBufferSize>& buffer, const FlatMap<K, V>& map)
+	{
+		pack_vector_bytes(buffer, map.keys());
+		pack_vector_bytes(buffer, map.values());
+	}
+
+	template <typename K, typename V>
+	void unpack_type(const char*& stream, FlatMap<K, V>& map)
+	{
+		unpack_vector_bytes(stream, map._keys);
+		unpack_vector_bytes(stream, map._values);
+		if (map._keys.size() != map._values.size())
+		{
+			assert_fail_msg("The flat map has a different number of keys and values");
+			map.clear();
+			return;
+		}
+
+		// The lookups assume sorted unique keys, the data is not trusted for that
+		if (!flat::is_sorted_unique(map._keys.begin(), map._keys.size()))
+		{
+			Vector<K> keys(*map._keys._allocator);
+			Vector<V> values(*map._values._allocator);
+			keys = map._keys;
+			values = map._values;
+			map.build(keys.begin(), values.begin(), keys.size());
+		}
+	}
+}
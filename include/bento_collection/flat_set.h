@@ -0,0 +1,78 @@
+#pragma once
+
+// Library includes
+#include "bento_collection/vector.h"
+#include "bento_base/stream.h"
+
+namespace bento {
+
+	namespace flat
+	{
+		// Index of the first key that is not lower than the requested one (num_keys if there is none).
+		// The loop has no data dependent branch, the comparison compiles to a conditional move.
+		template <typename K>
+		uint32_t lower_bound(const K* keys, uint32_t num_keys, const K& key);
+
+		// Check that the keys are sorted without duplicates, the order the lookups rely on
+		template <typename K>
+		bool is_sorted_unique(const K* keys, uint32_t num_keys);
+	}
+
+	// Set of unique keys stored sorted in a contiguous array
+	template <typename K>
+	class FlatSet
+	{
+	public:
+		ALLOCATOR_BASED;
+
+		// Type definition
+		typedef const K* const_iterator;
+
+		// Cst
+		FlatSet(IAllocator& allocator);
+
+		// Accessors
+		inline uint32_t size() const { return _keys.size(); }
+		inline const K& operator[](uint32_t index) const { return _keys[index]; }
+		inline const Vector<K>& keys() const { return _keys; }
+
+		// Insert a key, returns false if it was already in the set
+		bool insert(const K& key);
+
+		// Remove a key, returns false if it was not in the set
+		bool remove(const K& key);
+
+		// Is the key in the set
+		bool contains(const K& key) const;
+
+		// Index of the key in the set (UINT32_MAX if it is not in the set)
+		uint32_t index_of(const K& key) const;
+
+		// Replace the content of the set with unsorted keys (duplicates are dropped)
+		void build(const K* keys, uint32_t num_keys);
+
+		// Insert all the keys of an other set
+		void merge(const FlatSet<K>& set);
+
+		// set the size to 0
+		void clear();
+
+		// Iterator access
+		inline const_iterator begin() const { return _keys.begin(); }
+		inline const_iterator end() const { return _keys.end(); }
+
+	private:
+		Vector<K> _keys;
+
+		template <typename K2>
+		friend void unpack_type(const char*& stream, FlatSet<K2>& set);
+	};
+
+	// The keys are serialized as bytes, keys that are not sorted are sorted again at unpack time
+	template <typename K, typename TBufferSize>
+	void pack_type(Vector<char, TBufferSize>& buffer, const FlatSet<K>& set);
+	template <typename K>
+	void unpack_type(const char*& stream, FlatSet<K>& set);
+}
+
+#include "flat_set.inl"
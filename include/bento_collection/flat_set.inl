@@ -0,0 +1,165 @@
+// External includes
+#include <algorithm>
+
+namespace bento
+{
+	namespace flat
+	{
+		template <typename K>
+		uint32_t lower_bound(const K* keys, uint32_t num_keys, const K& key)
+		{
+			if (num_keys == 0)
+				return 0;
+
+			// The answer is always in [base, base + length]
+			const K* base = keys;
+			uint32_t length = num_keys;
+			while (length > 1)
+			{
+				uint32_t half = length / 2;
+				base = base[half - 1] < key ? base + half : base;
+				length -= half;
+			}
+			return (uint32_t)(base - keys) + (*base < key ? 1 : 0);
+		}
+
+		template <typename K>
+		bool is_sorted_unique(const K* keys, uint32_t num_keys)
+		{
+			for (uint32_t key_idx = 1; key_idx < num_keys; ++key_idx)
+			{
+				if (!(keys[key_idx - 1] < keys[key_idx]))
+					return false;
+			}
+			return true;
+		}
+	}
+
+	template <typename K>
+	FlatSet<K>::FlatSet(IAllocator& allocator)
+	: _keys(allocator)
+	{
+	}
+
+	template <typename K>
+	bool FlatSet<K>::insert(const K& key)
+	{
+		uint32_t num_keys = _keys.size();
+		uint32_t position = flat::lower_bound(_keys.begin(), num_keys, key);
+		if (position < num_keys && !(key < _keys[position]))
+			return false;
+
+		// Shift the greater keys to make room for the new one
+		_keys.resize(num_keys + 1);
+		for (uint32_t key_idx = num_keys; key_idx > position; --key_idx)
+			_keys[key_idx] = _keys[key_idx - 1];
+		_keys[position] = key;
+		return true;
+	}
+
+	template <typename K>
+	bool FlatSet<K>::remove(const K& key)
+	{
+		uint32_t position = index_of(key);
+		if (position == UINT32_MAX)
+			return false;
+
+		uint32_t num_keys = _keys.size();
+		for (uint32_t key_idx = position + 1; key_idx < num_keys; ++key_idx)
+			_keys[key_idx - 1] = _keys[key_idx];
+		_keys.resize(num_keys - 1);
+		return true;
+	}
+
+	template <typename K>
+	bool FlatSet<K>::contains(const K& key) const
+	{
+		return index_of(key) != UINT32_MAX;
+	}
+
+	template <typename K>
+	uint32_t FlatSet<K>::index_of(const K& key) const
+	{
+		uint32_t num_keys = _keys.size();
+		uint32_t position = flat::lower_bound(_keys.begin(), num_keys, key);
+		return (position < num_keys && !(key < _keys[position])) ? position : UINT32_MAX;
+	}
+
+	template <typename K>
+	void FlatSet<K>::build(const K* keys, uint32_t num_keys)
+	{
+		// One sort, then drop the duplicates
+		_keys.resize(num_keys);
+		for (uint32_t key_idx = 0; key_idx < num_keys; ++key_idx)
+			_keys[key_idx] = keys[key_idx];
+		std::sort(_keys.begin(), _keys.end());
+		K* last = std::unique(_keys.begin(), _keys.end());
+		_keys.resize((uint32_t)(last - _keys.begin()));
+	}
+
+	template <typename K>
+	void FlatSet<K>::merge(const FlatSet<K>& set)
+	{
+		uint32_t num_keys = _keys.size();
+		uint32_t num_other_keys = set._keys.size();
+		if (num_other_keys == 0)
+			return;
+
+		// Linear merge of the two sorted arrays
+		Vector<K> merged(*_keys._allocator);
+		merged.reserve(num_keys + num_other_keys);
+		uint32_t key_idx = 0, other_idx = 0;
+		while (key_idx < num_keys && other_idx < num_other_keys)
+		{
+			const K& key = _keys[key_idx];
+			const K& other_key = set._keys[other_idx];
+			if (key < other_key)
+			{
+				merged.push_back(key);
+				++key_idx;
+			}
+			else if (other_key < key)
+			{
+				merged.push_back(other_key);
+				++other_idx;
+			}
+			else
+			{
+				merged.push_back(key);
+				++key_idx;
+				++other_idx;
+			}
+		}
+		for (; key_idx < num_keys; ++key_idx)
+			merged.push_back(_keys[key_idx]);
+		for (; other_idx < num_other_keys; ++other_idx)
+			merged.push_back(set._keys[other_idx]);
+		_keys = merged;
+	}
+
+	template <typename K>
+	void FlatSet<K>::clear()
+	{
+		_keys.clear();
+	}
+
+	template <typename K, typename TBufferSize>
+	void pack_type(Vector<char, TBufferSize>& buffer, const FlatSet<K>& set)
+	{
+		pack_vector_bytes(buffer, set.keys());
+	}
+
+	template <typename K>
+	void unpack_type(const char*& stream, FlatSet<K>& set)
+	{
+		unpack_vector_bytes(stream, set._keys);
+
+		// The lookups assume sorted unique keys, the data is not trusted for that
+		if (!flat::is_sorted_unique(set._keys.begin(), set._keys.size()))
+		{
+			Vector<K> keys(*set._keys._allocator);
+			keys = set._keys;
+			set.build(keys.begin(), keys.size());
+		}
+	}
+}
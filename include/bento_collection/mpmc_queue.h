@@ -0,0 +1,63 @@
+#pragma once
+
+// Library includes
+#include "bento_base/platform.h"
+#include "bento_memory/common.h"
+
+// External includes
+#include <atomic>
+
+namespace bento {
+
+	// Bounded lock-free queue that can be used by multiple producers and consumers at the same time.
+	// Every slot carries a sequence number that tells if it is ready to be written or read.
+	template <typename T>
+	class MPMCQueue
+	{
+	public:
+		ALLOCATOR_BASED;
+
+		// Cst & Dst (the capacity is rounded up to a power of two)
+		MPMCQueue(IAllocator& allocator, uint32_t capacity);
+		~MPMCQueue();
+
+		// Push an element, returns false if the queue is full
+		bool try_push(const T& value);
+
+		// Pop an element, returns false if the queue is empty
+		bool try_pop(T& value);
+
+		// Accessors
+		inline uint32_t capacity() const { return _mask + 1; }
+
+		// Number of elements in the queue (only a hint while other threads are using it)
+		uint32_t size_approx() const;
+
+	private:
+		struct Slot
+		{
+			std::atomic<size_t> sequence;
+			T value;
+		};
+
+		void construct(T* p, const Int2Type<true> &) { new (p) T(_allocator); }
+		void construct(T* p, const Int2Type<false> &) { new (p) T(); }
+
+		// Non copyable
+		MPMCQueue(const MPMCQueue&);
+		MPMCQueue& operator=(const MPMCQueue&);
+
+	private:
+		// Data shared by all the threads but only read
+		Slot* _slots;
+		size_t _mask;
+		IAllocator& _allocator;
+
+		// The producer and consumer positions live on their own cache lines
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> _enqueue_pos;
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> _dequeue_pos;
+		char _padding[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+	};
+}
+
+#include "mpmc_queue.inl"
@@ -0,0 +1,113 @@
+
+namespace bento
+{
+	template <typename T>
+	MPMCQueue<T>::MPMCQueue(IAllocator& allocator, uint32_t capacity)
+	: _slots(nullptr)
+	, _mask(0)
+	, _allocator(allocator)
+	, _enqueue_pos(0)
+	, _dequeue_pos(0)
+	{
+		// Round the capacity to the next power of two
+		size_t num_slots = 2;
+		while (num_slots < capacity)
+			num_slots *= 2;
+		_mask = num_slots - 1;
+
+		// Every slot starts ready to be written for the first lap
+		_slots = static_cast<Slot*>(_allocator.allocate(sizeof(Slot) * num_slots, CACHE_LINE_SIZE));
+		for (size_t slot_idx = 0; slot_idx < num_slots; ++slot_idx)
+		{
+			new (&_slots[slot_idx].sequence) std::atomic<size_t>(slot_idx);
+			construct(&_slots[slot_idx].value, IS_ALLOCATOR_BASED_TYPE(T)());
+		}
+	}
+
+	template <typename T>
+	MPMCQueue<T>::~MPMCQueue()
+	{
+		size_t num_slots = _mask + 1;
+		for (size_t slot_idx = 0; slot_idx < num_slots; ++slot_idx)
+		{
+			_slots[slot_idx].value.~T();
+		}
+		_allocator.deallocate(_slots);
+	}
+
+	template <typename T>
+	bool MPMCQueue<T>::try_push(const T& value)
+	{
+		Slot* slot;
+		size_t position = _enqueue_pos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			slot = &_slots[position & _mask];
+			size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+			if (difference == 0)
+			{
+				// The slot is free for this lap, try to claim it
+				if (_enqueue_pos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (difference < 0)
+			{
+				// The slot has not been consumed since the previous lap, the queue is full
+				return false;
+			}
+			else
+			{
+				// An other producer claimed it first
+				position = _enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		// Write the value and publish it to the consumers
+		slot->value = value;
+		slot->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T>
+	bool MPMCQueue<T>::try_pop(T& value)
+	{
+		Slot* slot;
+		size_t position = _dequeue_pos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			slot = &_slots[position & _mask];
+			size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+			if (difference == 0)
+			{
+				// The slot has been written for this lap, try to claim it
+				if (_dequeue_pos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (difference < 0)
+			{
+				// Nothing has been written there yet, the queue is empty
+				return false;
+			}
+			else
+			{
+				// An other consumer claimed it first
+				position = _dequeue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		// Read the value and release the slot for the next lap
+		value = slot->value;
+		slot->sequence.store(position + _mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T>
+	uint32_t MPMCQueue<T>::size_approx() const
+	{
+		size_t enqueue_pos = _enqueue_pos.load(std::memory_order_relaxed);
+		size_t dequeue_pos = _dequeue_pos.load(std::memory_order_relaxed);
+		return enqueue_pos > dequeue_pos ? (uint32_t)(enqueue_pos - dequeue_pos) : 0;
+	}
+}
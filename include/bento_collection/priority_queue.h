@@ -0,0 +1,134 @@
+#pragma once
+
+// Library includes
+#include "bento_base/security.h"
+#include "bento_collection/vector.h"
+
+namespace bento {
+
+	// Default comparator, the smallest element has the highest priority
+	template <typename T>
+	struct Less
+	{
+		inline bool operator()(const T& a, const T& b) const { return a < b; }
+	};
+
+	// Binary heap primitives on a raw array, the element for which compare(a, b) holds for every b is at index 0
+	namespace heap
+	{
+		template <typename T, typename Compare>
+		void sift_up(T* data, uint32_t index, Compare compare);
+
+		template <typename T, typename Compare>
+		void sift_down(T* data, uint32_t size, uint32_t index, Compare compare);
+	}
+
+	// Priority queue stored as a binary heap in a Vector
+	template <typename T, typename Compare = Less<T>>
+	class PriorityQueue
+	{
+	public:
+		ALLOCATOR_BASED;
+
+		// Cst
+		PriorityQueue(IAllocator& allocator, Compare compare = Compare());
+
+		// Accessors
+		inline uint32_t size() const { return _heap.size(); }
+		inline bool empty() const { return _heap.size() == 0; }
+
+		// Element with the highest priority
+		inline const T& top() const { return _heap[0]; }
+
+		// Insert an element
+		void push(const T& value);
+
+		// Remove the element with the highest priority
+		void pop();
+
+		// set the size to 0
+		void clear();
+
+	private:
+		Vector<T> _heap;
+		Compare _compare;
+	};
+
+	// Priority queue over a fixed range of ids [0, num_ids) with a priority attached to each id.
+	// An index map keeps track of the position of every id in the heap, which allows updating
+	// (decrease-key) or removing an id that is already queued.
+	template <typename T, typename Compare = Less<T>>
+	class IndexedPriorityQueue
+	{
+	public:
+		ALLOCATOR_BASED;
+
+		// Cst
+		IndexedPriorityQueue(IAllocator& allocator, uint32_t num_ids, Compare compare = Compare());
+
+		// Accessors
+		inline uint32_t size() const { return _heap.size(); }
+		inline bool empty() const { return _heap.size() == 0; }
+		inline bool contains(uint32_t id) const { return _positions[id] != UINT32_MAX; }
+		inline const T& priority(uint32_t id) const { return _priorities[id]; }
+
+		// Id and priority of the element with the highest priority
+		inline uint32_t top() const { return _heap[0]; }
+		inline const T& top_priority() const { return _priorities[_heap[0]]; }
+
+		// Insert an id that is not queued yet
+		void push(uint32_t id, const T& priority);
+
+		// Change the priority of a queued id (either direction)
+		void update(uint32_t id, const T& priority);
+
+		// Insert the id or change its priority if it is already queued
+		void push_or_update(uint32_t id, const T& priority);
+
+		// Remove the id with the highest priority and return it
+		uint32_t pop();
+
+		// Remove a queued id, returns false if it was not queued
+		bool remove(uint32_t id);
+
+		// Remove all the ids
+		void clear();
+
+	private:
+		void sift_up(uint32_t position);
+		void sift_down(uint32_t position);
+		void place(uint32_t position, uint32_t id);
+
+	private:
+		Vector<uint32_t> _heap;
+		Vector<uint32_t> _positions;
+		Vector<T> _priorities;
+		Compare _compare;
+	};
+
+	// Partial selection helpers, cheaper than a full sort when only a few elements are needed
+	namespace selection
+	{
+		// Copy the k elements with the highest priority in output, ordered by priority, returns the number of elements written.
+		// Runs in O(n log k) with a bounded heap, the input is not modified.
+		template <typename T, typename Compare>
+		uint32_t top_k(const T* data, uint32_t num_elements, uint32_t k, T* output, Compare compare);
+
+		template <typename T>
+		uint32_t top_k(const T* data, uint32_t num_elements, uint32_t k, T* output);
+
+		// Reorder the array so that the element at nth is the one a full sort would put there and return it.
+		// Elements before nth do not come after it in the order and reciprocally.
+		template <typename T, typename Compare>
+		T nth(T* data, uint32_t num_elements, uint32_t nth, Compare compare);
+
+		template <typename T>
+		T nth(T* data, uint32_t num_elements, uint32_t nth);
+
+		// Value under which a fraction (in [0, 1]) of the samples falls, the array is reordered (T() for an empty array)
+		template <typename T>
+		T percentile(T* data, uint32_t num_elements, float fraction);
+	}
+}
+
+#include "priority_queue.inl"
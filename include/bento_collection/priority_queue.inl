@@ -0,0 +1,275 @@
+// External includes
+#include <algorithm>
+
+namespace bento
+{
+	namespace heap
+	{
+		template <typename T, typename Compare>
+		void sift_up(T* data, uint32_t index, Compare compare)
+		{
+			T value = data[index];
+			while (index > 0)
+			{
+				uint32_t parent = (index - 1) / 2;
+				if (!compare(value, data[parent]))
+					break;
+				data[index] = data[parent];
+				index = parent;
+			}
+			data[index] = value;
+		}
+
+		template <typename T, typename Compare>
+		void sift_down(T* data, uint32_t size, uint32_t index, Compare compare)
+		{
+			T value = data[index];
+			for (;;)
+			{
+				// Pick the child with the highest priority
+				uint32_t child = 2 * index + 1;
+				if (child >= size)
+					break;
+				if (child + 1 < size && compare(data[child + 1], data[child]))
+					++child;
+				if (!compare(data[child], value))
+					break;
+				data[index] = data[child];
+				index = child;
+			}
+			data[index] = value;
+		}
+
+		// Swaps the arguments of a comparator
+		template <typename Compare>
+		struct Inverse
+		{
+			Inverse(Compare compare)
+			: _compare(compare)
+			{
+			}
+
+			template <typename T>
+			inline bool operator()(const T& a, const T& b) const { return _compare(b, a); }
+
+			Compare _compare;
+		};
+	}
+
+	template <typename T, typename Compare>
+	PriorityQueue<T, Compare>::PriorityQueue(IAllocator& allocator, Compare compare)
+	: _heap(allocator)
+	, _compare(compare)
+	{
+	}
+
+	template <typename T, typename Compare>
+	void PriorityQueue<T, Compare>::push(const T& value)
+	{
+		_heap.push_back(value);
+		heap::sift_up(_heap.begin(), _heap.size() - 1, _compare);
+	}
+
+	template <typename T, typename Compare>
+	void PriorityQueue<T, Compare>::pop()
+	{
+		// Move the last element at the root and restore the heap
+		uint32_t last_idx = _heap.size() - 1;
+		_heap[0] = _heap[last_idx];
+		_heap.resize(last_idx);
+		if (last_idx > 1)
+			heap::sift_down(_heap.begin(), last_idx, 0, _compare);
+	}
+
+	template <typename T, typename Compare>
+	void PriorityQueue<T, Compare>::clear()
+	{
+		_heap.clear();
+	}
+
+	template <typename T, typename Compare>
+	IndexedPriorityQueue<T, Compare>::IndexedPriorityQueue(IAllocator& allocator, uint32_t num_ids, Compare compare)
+	: _heap(allocator)
+	, _positions(allocator, num_ids)
+	, _priorities(allocator, num_ids)
+	, _compare(compare)
+	{
+		for (uint32_t id = 0; id < num_ids; ++id)
+			_positions[id] = UINT32_MAX;
+	}
+
+	template <typename T, typename Compare>
+	void IndexedPriorityQueue<T, Compare>::place(uint32_t position, uint32_t id)
+	{
+		_heap[position] = id;
+		_positions[id] = position;
+	}
+
+	template <typename T, typename Compare>
+	void IndexedPriorityQueue<T, Compare>::sift_up(uint32_t position)
+	{
+		uint32_t id = _heap[position];
+		while (position > 0)
+		{
+			uint32_t parent = (position - 1) / 2;
+			if (!_compare(_priorities[id], _priorities[_heap[parent]]))
+				break;
+			place(position, _heap[parent]);
+			position = parent;
+		}
+		place(position, id);
+	}
+
+	template <typename T, typename Compare>
+	void IndexedPriorityQueue<T, Compare>::sift_down(uint32_t position)
+	{
+		uint32_t id = _heap[position];
+		uint32_t size = _heap.size();
+		for (;;)
+		{
+			uint32_t child = 2 * position + 1;
+			if (child >= size)
+				break;
+			if (child + 1 < size && _compare(_priorities[_heap[child + 1]], _priorities[_heap[child]]))
+				++child;
+			if (!_compare(_priorities[_heap[child]], _priorities[id]))
+				break;
+			place(position, _heap[child]);
+			position = child;
+		}
+		place(position, id);
+	}
+
+	template <typename T, typename Compare>
+	void IndexedPriorityQueue<T, Compare>::push(uint32_t id, const T& priority)
+	{
+		_priorities[id] = priority;
+		_heap.push_back(id);
+		sift_up(_heap.size() - 1);
+	}
+
+	template <typename T, typename Compare>
+	void IndexedPriorityQueue<T, Compare>::update(uint32_t id, const T& priority)
+	{
+		// Only one of the two sifts will move the id
+		uint32_t position = _positions[id];
+		_priorities[id] = priority;
+		sift_up(position);
+		sift_down(_positions[id]);
+	}
+
+	template <typename T, typename Compare>
+	void IndexedPriorityQueue<T, Compare>::push_or_update(uint32_t id, const T& priority)
+	{
+		if (contains(id))
+			update(id, priority);
+		else
+			push(id, priority);
+	}
+
+	template <typename T, typename Compare>
+	uint32_t IndexedPriorityQueue<T, Compare>::pop()
+	{
+		uint32_t id = _heap[0];
+		remove(id);
+		return id;
+	}
+
+	template <typename T, typename Compare>
+	bool IndexedPriorityQueue<T, Compare>::remove(uint32_t id)
+	{
+		uint32_t position = _positions[id];
+		if (position == UINT32_MAX)
+			return false;
+
+		// Move the last id in the hole and restore the heap around it
+		uint32_t last_idx = _heap.size() - 1;
+		uint32_t last_id = _heap[last_idx];
+		_heap.resize(last_idx);
+		_positions[id] = UINT32_MAX;
+		if (position != last_idx)
+		{
+			place(position, last_id);
+			sift_up(position);
+			sift_down(_positions[last_id]);
+		}
+		return true;
+	}
+
+	template <typename T, typename Compare>
+	void IndexedPriorityQueue<T, Compare>::clear()
+	{
+		uint32_t size = _heap.size();
+		for (uint32_t position = 0; position < size; ++position)
+			_positions[_heap[position]] = UINT32_MAX;
+		_heap.clear();
+	}
+
+	namespace selection
+	{
+		template <typename T, typename Compare>
+		uint32_t top_k(const T* data, uint32_t num_elements, uint32_t k, T* output, Compare compare)
+		{
+			// The output is used as a heap whose root is the worst of the kept elements
+			heap::Inverse<Compare> inverse(compare);
+			uint32_t num_kept = 0;
+			for (uint32_t ele_idx = 0; ele_idx < num_elements; ++ele_idx)
+			{
+				const T& value = data[ele_idx];
+				if (num_kept < k)
+				{
+					output[num_kept] = value;
+					heap::sift_up(output, num_kept++, inverse);
+				}
+				else if (num_kept > 0 && compare(value, output[0]))
+				{
+					output[0] = value;
+					heap::sift_down(output, num_kept, 0, inverse);
+				}
+			}
+
+			// Heap sort in place, moving the worst element at the end each time
+			for (uint32_t heap_size = num_kept; heap_size > 1; --heap_size)
+			{
+				T worst = output[0];
+				output[0] = output[heap_size - 1];
+				output[heap_size - 1] = worst;
+				heap::sift_down(output, heap_size - 1, 0, inverse);
+			}
+			return num_kept;
+		}
+
+		template <typename T>
+		uint32_t top_k(const T* data, uint32_t num_elements, uint32_t k, T* output)
+		{
+			return top_k(data, num_elements, k, output, Less<T>());
+		}
+
+		template <typename T, typename Compare>
+		T nth(T* data, uint32_t num_elements, uint32_t nth, Compare compare)
+		{
+			assert_msg(nth < num_elements, "The selected rank is outside of the array");
+			if (nth >= num_elements)
+				return T();
+			std::nth_element(data, data + nth, data + num_elements, compare);
+			return data[nth];
+		}
+
+		template <typename T>
+		T nth(T* data, uint32_t num_elements, uint32_t nth)
+		{
+			return selection::nth(data, num_elements, nth, Less<T>());
+		}
+
+		template <typename T>
+		T percentile(T* data, uint32_t num_elements, float fraction)
+		{
+			assert_msg(num_elements > 0, "Percentile of an empty array");
+			if (num_elements == 0)
+				return T();
+			fraction = fraction < 0.0f ? 0.0f : (fraction > 1.0f ? 1.0f : fraction);
+			uint32_t rank = (uint32_t)(fraction * (num_elements - 1) + 0.5f);
+			return selection::nth(data, num_elements, rank, Less<T>());
+		}
+	}
+}
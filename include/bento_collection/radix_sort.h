@@ -0,0 +1,35 @@
+#pragma once
+
+// Library includes
+#include "bento_base/platform.h"
+#include "bento_memory/common.h"
+
+namespace bento {
+
+	// Stable least significant digit radix sort on records with 32 or 64 bit unsigned keys.
+	// The key functor maps a record to its key (uint32_t or uint64_t), the helpers below
+	// turn floats and signed values into keys that sort in the same order.
+	// Records are moved with plain copies, they should be cheap to copy.
+	namespace radix_sort
+	{
+		// Order preserving conversions to unsigned keys
+		inline uint32_t float_key(float value);
+		inline uint64_t double_key(double value);
+		inline uint32_t int_key(int32_t value) { return (uint32_t)value ^ 0x80000000u; }
+		inline uint64_t int_key(int64_t value) { return (uint64_t)value ^ 0x8000000000000000ull; }
+
+		// Sort using a caller provided scratch buffer of num_elements records
+		template<typename T, typename KeyFunctor>
+		void sort(T* data, uint32_t num_elements, KeyFunctor key, T* scratch);
+
+		// Sort using a scratch buffer allocated from the allocator
+		template<typename T, typename KeyFunctor>
+		void sort(T* data, uint32_t num_elements, KeyFunctor key, IAllocator& allocator);
+
+		// Sort with the histogram and scatter passes split across threads, small arrays fall back to the single threaded version
+		template<typename T, typename KeyFunctor>
+		void parallel_sort(T* data, uint32_t num_elements, KeyFunctor key, IAllocator& allocator, uint32_t num_threads);
+	}
+}
+
+#include "radix_sort.inl"
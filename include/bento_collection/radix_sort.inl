@@ -0,0 +1,245 @@
+// External includes
+#include <condition_variable>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace bento
+{
+	namespace radix_sort
+	{
+		// Size of a digit in bits and number of buckets per pass
+		const uint32_t RADIX_BITS = 8;
+		const uint32_t RADIX_BUCKETS = 1 << RADIX_BITS;
+
+		// Under this number of elements per thread, the parallel sort is not worth it
+		const uint32_t PARALLEL_SORT_THRESHOLD = 1 << 16;
+
+		inline uint32_t float_key(float value)
+		{
+			// Flip all the bits of negative values, only the sign bit of positive ones
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			uint32_t mask = (uint32_t)(-(int32_t)(bits >> 31)) | 0x80000000u;
+			return bits ^ mask;
+		}
+
+		inline uint64_t double_key(double value)
+		{
+			uint64_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			uint64_t mask = (uint64_t)(-(int64_t)(bits >> 63)) | 0x8000000000000000ull;
+			return bits ^ mask;
+		}
+
+		template<typename KeyType>
+		inline uint32_t digit(KeyType key, uint32_t pass)
+		{
+			return (uint32_t)(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+		}
+
+		// A pass can be skipped if all the elements share the same digit
+		inline bool trivial_pass(const uint32_t* histogram, uint32_t num_elements)
+		{
+			for (uint32_t bucket_idx = 0; bucket_idx < RADIX_BUCKETS; ++bucket_idx)
+			{
+				if (histogram[bucket_idx] != 0)
+					return histogram[bucket_idx] == num_elements;
+			}
+			return true;
+		}
+
+		template<typename T, typename KeyFunctor>
+		void sort(T* data, uint32_t num_elements, KeyFunctor key, T* scratch)
+		{
+			typedef decltype(key(*data)) KeyType;
+			const uint32_t num_passes = sizeof(KeyType);
+			if (num_elements < 2)
+				return;
+
+			// Build the histograms of all the passes with a single read of the keys
+			uint32_t histograms[sizeof(KeyType)][RADIX_BUCKETS];
+			memset(histograms, 0, sizeof(histograms));
+			for (uint32_t ele_idx = 0; ele_idx < num_elements; ++ele_idx)
+			{
+				KeyType current_key = key(data[ele_idx]);
+				for (uint32_t pass = 0; pass < num_passes; ++pass)
+					histograms[pass][digit(current_key, pass)]++;
+			}
+
+			T* source = data;
+			T* target = scratch;
+			for (uint32_t pass = 0; pass < num_passes; ++pass)
+			{
+				uint32_t* histogram = histograms[pass];
+				if (trivial_pass(histogram, num_elements))
+					continue;
+
+				// Turn the histogram into write offsets
+				uint32_t offset = 0;
+				for (uint32_t bucket_idx = 0; bucket_idx < RADIX_BUCKETS; ++bucket_idx)
+				{
+					uint32_t count = histogram[bucket_idx];
+					histogram[bucket_idx] = offset;
+					offset += count;
+				}
+
+				// Scatter the records in the target buffer
+				for (uint32_t ele_idx = 0; ele_idx < num_elements; ++ele_idx)
+				{
+					const T& record = source[ele_idx];
+					target[histogram[digit(key(record), pass)]++] = record;
+				}
+
+				T* tmp = source;
+				source = target;
+				target = tmp;
+			}
+
+			// An odd number of passes leaves the result in the scratch buffer
+			if (source != data)
+			{
+				for (uint32_t ele_idx = 0; ele_idx < num_elements; ++ele_idx)
+					data[ele_idx] = source[ele_idx];
+			}
+		}
+
+		template<typename T, typename KeyFunctor>
+		void sort(T* data, uint32_t num_elements, KeyFunctor key, IAllocator& allocator)
+		{
+			if (num_elements < 2)
+				return;
+			T* scratch = (T*)allocator.allocate(sizeof(T) * (size_t)num_elements, alignof(T) > 4 ? alignof(T) : 4);
+			sort(data, num_elements, key, scratch);
+			allocator.deallocate(scratch);
+		}
+
+		// Reusable barrier that keeps the sort workers in lockstep between the phases of a pass
+		class PassBarrier
+		{
+		public:
+			PassBarrier(uint32_t num_threads)
+			: _num_threads(num_threads)
+			, _num_waiting(0)
+			, _generation(0)
+			{
+			}
+
+			void wait()
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				uint32_t generation = _generation;
+				if (++_num_waiting == _num_threads)
+				{
+					_num_waiting = 0;
+					++_generation;
+					_condition.notify_all();
+				}
+				else
+				{
+					_condition.wait(lock, [&]() { return generation != _generation; });
+				}
+			}
+
+		private:
+			std::mutex _mutex;
+			std::condition_variable _condition;
+			uint32_t _num_threads;
+			uint32_t _num_waiting;
+			uint32_t _generation;
+		};
+
+		template<typename T, typename KeyFunctor>
+		void parallel_sort(T* data, uint32_t num_elements, KeyFunctor key, IAllocator& allocator, uint32_t num_threads)
+		{
+			typedef decltype(key(*data)) KeyType;
+			const uint32_t num_passes = sizeof(KeyType);
+
+			// Clamp the number of threads so that every one of them has enough work
+			uint32_t max_threads = num_elements / PARALLEL_SORT_THRESHOLD;
+			num_threads = num_threads < max_threads ? num_threads : max_threads;
+			if (num_threads < 2)
+			{
+				sort(data, num_elements, key, allocator);
+				return;
+			}
+
+			T* scratch = (T*)allocator.allocate(sizeof(T) * (size_t)num_elements, alignof(T) > 4 ? alignof(T) : 4);
+			uint32_t* histograms = (uint32_t*)allocator.allocate(sizeof(uint32_t) * RADIX_BUCKETS * num_threads, 64);
+			uint32_t chunk_size = (num_elements + num_threads - 1) / num_threads;
+			PassBarrier barrier(num_threads);
+			bool trivial = false;
+
+			// The workers live for the whole sort, they all take the same decisions so they swap the buffers in sync
+			auto worker = [&](uint32_t thread_idx) {
+				uint32_t* histogram = histograms + thread_idx * RADIX_BUCKETS;
+				uint32_t first = thread_idx * chunk_size;
+				uint32_t last = first + chunk_size < num_elements ? first + chunk_size : num_elements;
+				T* source = data;
+				T* target = scratch;
+				for (uint32_t pass = 0; pass < num_passes; ++pass)
+				{
+					// Every thread builds the histogram of its chunk
+					memset(histogram, 0, sizeof(uint32_t) * RADIX_BUCKETS);
+					for (uint32_t ele_idx = first; ele_idx < last; ++ele_idx)
+						histogram[digit(key(source[ele_idx]), pass)]++;
+					barrier.wait();
+
+					// Turn the histograms into per thread write offsets (bucket major, then thread order to stay stable)
+					if (thread_idx == 0)
+					{
+						uint32_t offset = 0;
+						trivial = false;
+						for (uint32_t bucket_idx = 0; bucket_idx < RADIX_BUCKETS; ++bucket_idx)
+						{
+							uint32_t bucket_start = offset;
+							for (uint32_t other_idx = 0; other_idx < num_threads; ++other_idx)
+							{
+								uint32_t& slot = histograms[other_idx * RADIX_BUCKETS + bucket_idx];
+								uint32_t count = slot;
+								slot = offset;
+								offset += count;
+							}
+							if (offset - bucket_start == num_elements)
+								trivial = true;
+						}
+					}
+					barrier.wait();
+					if (trivial)
+						continue;
+
+					// Every thread scatters its chunk, the next pass reads the target once all of them are done
+					for (uint32_t ele_idx = first; ele_idx < last; ++ele_idx)
+					{
+						const T& record = source[ele_idx];
+						target[histogram[digit(key(record), pass)]++] = record;
+					}
+					barrier.wait();
+
+					T* tmp = source;
+					source = target;
+					target = tmp;
+				}
+				return source;
+			};
+
+			std::vector<std::thread> workers;
+			workers.reserve(num_threads - 1);
+			for (uint32_t thread_idx = 1; thread_idx < num_threads; ++thread_idx)
+				workers.push_back(std::thread(worker, thread_idx));
+			T* source = worker(0);
+			for (uint32_t thread_idx = 0; thread_idx < num_threads - 1; ++thread_idx)
+				workers[thread_idx].join();
+
+			if (source != data)
+			{
+				for (uint32_t ele_idx = 0; ele_idx < num_elements; ++ele_idx)
+					data[ele_idx] = source[ele_idx];
+			}
+
+			allocator.deallocate(histograms);
+			allocator.deallocate(scratch);
+		}
+	}
+}
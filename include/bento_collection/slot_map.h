@@ -0,0 +1,75 @@
+#pragma once
+
+// Library includes
+#include "bento_collection/vector.h"
+
+namespace bento {
+
+	// Handle on an element of a slot map, the high 32 bits hold the generation of the slot and the low ones its index.
+	// Generations start at 1, so 0 is never a valid handle (matching the null backend handles).
+	typedef uint64_t SlotHandle;
+
+	// Container that hands out generation checked handles on its elements.
+	// The elements are stored densely (no holes), so the handles stay valid when other elements move around.
+	template <typename T>
+	class SlotMap
+	{
+	public:
+		ALLOCATOR_BASED;
+
+		// Type definition
+		typedef T* iterator;
+		typedef const T* const_iterator;
+
+		// Cst
+		SlotMap(IAllocator& allocator);
+
+		// Insert an element and return its handle
+		SlotHandle insert(const T& value);
+
+		// Remove an element, returns false if the handle is not valid anymore
+		bool remove(SlotHandle handle);
+
+		// Is the handle still pointing to a live element
+		bool valid(SlotHandle handle) const;
+
+		// Access an element (nullptr if the handle is not valid anymore)
+		T* get(SlotHandle handle);
+		const T* get(SlotHandle handle) const;
+
+		// Handle of the element stored at a given dense index
+		SlotHandle handle_at(uint32_t index) const;
+
+		// Remove all the elements (all the handles become invalid)
+		void clear();
+
+		// Accessors
+		inline uint32_t size() const { return _data.size(); }
+		inline T& operator[](uint32_t index) { return _data[index]; }
+		inline const T& operator[](uint32_t index) const { return _data[index]; }
+
+		// Iterator access over the live elements
+		inline iterator begin() { return _data.begin(); }
+		inline const_iterator begin() const { return _data.begin(); }
+		inline iterator end() { return _data.end(); }
+		inline const_iterator end() const { return _data.end(); }
+
+	private:
+		struct Slot
+		{
+			// Dense index of the element if the slot is used, next free slot otherwise
+			uint32_t index;
+			uint32_t generation;
+		};
+
+		const Slot* find_slot(SlotHandle handle) const;
+
+	private:
+		Vector<T> _data;
+		Vector<uint32_t> _dense_to_slot;
+		Vector<Slot> _slots;
+		uint32_t _free_slot;
+	};
+}
+
+#include "slot_map.inl"
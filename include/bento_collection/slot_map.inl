@@ -0,0 +1,111 @@
+
+namespace bento
+{
+	template <typename T>
+	SlotMap<T>::SlotMap(IAllocator& allocator)
+	: _data(allocator)
+	, _dense_to_slot(allocator)
+	, _slots(allocator)
+	, _free_slot(UINT32_MAX)
+	{
+	}
+
+	template <typename T>
+	SlotHandle SlotMap<T>::insert(const T& value)
+	{
+		// Recycle a free slot if possible
+		uint32_t slot_idx = _free_slot;
+		if (slot_idx != UINT32_MAX)
+		{
+			_free_slot = _slots[slot_idx].index;
+		}
+		else
+		{
+			slot_idx = _slots.size();
+			Slot& new_slot = _slots.extend();
+			new_slot.generation = 1;
+		}
+
+		// The element goes at the end of the dense array
+		Slot& slot = _slots[slot_idx];
+		slot.index = _data.size();
+		_data.push_back(value);
+		_dense_to_slot.push_back(slot_idx);
+		return ((uint64_t)slot.generation << 32) | slot_idx;
+	}
+
+	template <typename T>
+	bool SlotMap<T>::remove(SlotHandle handle)
+	{
+		const Slot* slot_ptr = find_slot(handle);
+		if (slot_ptr == nullptr)
+			return false;
+
+		// Move the last element in the hole to keep the array dense
+		uint32_t slot_idx = (uint32_t)handle;
+		uint32_t dense_idx = slot_ptr->index;
+		uint32_t last_idx = _data.size() - 1;
+		if (dense_idx != last_idx)
+		{
+			_data[dense_idx] = _data[last_idx];
+			_dense_to_slot[dense_idx] = _dense_to_slot[last_idx];
+			_slots[_dense_to_slot[dense_idx]].index = dense_idx;
+		}
+		_data.resize(last_idx);
+		_dense_to_slot.resize(last_idx);
+
+		// Invalidate the previous handles and push the slot in the free list
+		Slot& slot = _slots[slot_idx];
+		slot.generation = slot.generation == UINT32_MAX ? 1 : slot.generation + 1;
+		slot.index = _free_slot;
+		_free_slot = slot_idx;
+		return true;
+	}
+
+	template <typename T>
+	const typename SlotMap<T>::Slot* SlotMap<T>::find_slot(SlotHandle handle) const
+	{
+		uint32_t slot_idx = (uint32_t)handle;
+		uint32_t generation = (uint32_t)(handle >> 32);
+		if (slot_idx >= _slots.size() || _slots[slot_idx].generation != generation)
+			return nullptr;
+		return &_slots[slot_idx];
+	}
+
+	template <typename T>
+	bool SlotMap<T>::valid(SlotHandle handle) const
+	{
+		return find_slot(handle) != nullptr;
+	}
+
+	template <typename T>
+	T* SlotMap<T>::get(SlotHandle handle)
+	{
+		const Slot* slot = find_slot(handle);
+		return slot != nullptr ? &_data[slot->index] : nullptr;
+	}
+
+	template <typename T>
+	const T* SlotMap<T>::get(SlotHandle handle) const
+	{
+		const Slot* slot = find_slot(handle);
+		return slot != nullptr ? &_data[slot->index] : nullptr;
+	}
+
+	template <typename T>
+	SlotHandle SlotMap<T>::handle_at(uint32_t index) const
+	{
+		uint32_t slot_idx = _dense_to_slot[index];
+		return ((uint64_t)_slots[slot_idx].generation << 32) | slot_idx;
+	}
+
+	template <typename T>
+	void SlotMap<T>::clear()
+	{
+		uint32_t num_elements = _data.size();
+		for (uint32_t ele_idx = num_elements; ele_idx > 0; --ele_idx)
+		{
+			remove(handle_at(ele_idx - 1));
+		}
+	}
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+// Library includes
+#include "bento_base/platform.h"
+#include "bento_memory/common.h"
+#include "bento_collection/span.h"
+
+// External includes
+#include <type_traits>
+#include <string.h>
+
+namespace bento {
+
+	namespace soa
+	{
+		// Type of the Ith field of a parameter pack
+		template <uint32_t I, typename T, typename... Ts>
+		struct FieldType
+		{
+			typedef typename FieldType<I - 1, Ts...>::type type;
+		};
+
+		template <typename T, typename... Ts>
+		struct FieldType<0, T, Ts...>
+		{
+			typedef T type;
+		};
+
+		// Are all the types of a parameter pack trivially copyable
+		template <typename... Ts>
+		struct AllTriviallyCopyable : std::true_type
+		{
+		};
+
+		template <typename T, typename... Ts>
+		struct AllTriviallyCopyable<T, Ts...> : std::integral_constant<bool, std::is_trivially_copyable<T>::value && AllTriviallyCopyable<Ts...>::value>
+		{
+		};
+	}
+
+	// Structure of arrays container, every field is stored in its own array.
+	// All the arrays live in a single allocation and each one starts on a cache line.
+	// Elements are moved with memcpy and are not initialized, the field types must be trivially copyable.
+	template <typename... Ts>
+	class SoAVector
+	{
+	public:
+		ALLOCATOR_BASED;
+		static_assert(sizeof...(Ts) > 0, "SoAVector requires at least one field");
+		static_assert(soa::AllTriviallyCopyable<Ts...>::value, "SoAVector fields must be trivially copyable");
+
+		// Type definition
+		static const uint32_t num_fields = sizeof...(Ts);
+		template <uint32_t I>
+		using field_type = typename soa::FieldType<I, Ts...>::type;
+
+		// Cst & Dst
+		SoAVector(IAllocator& allocator);
+		SoAVector(IAllocator& allocator, uint32_t size);
+		~SoAVector();
+
+		// Accessors
+		inline uint32_t size() const { return _size; }
+		inline uint32_t capacity() const { return _capacity; }
+
+		// Resize the container (the new elements are not initialized)
+		void resize(uint32_t size);
+
+		// Reserve memory in the container
+		void reserve(uint32_t space);
+
+		// set the size to 0
+		void clear();
+
+		// Free the memory
+		void free();
+
+		// Append an element, one value per field
+		void push_back(const Ts&... values);
+
+		// Append an uninitialized element and return its index
+		uint32_t extend();
+
+		// Remove an element by moving the last one in its place
+		void remove_swap(uint32_t index);
+
+		// Per field access
+		template <uint32_t I>
+		inline field_type<I>* field() { return static_cast<field_type<I>*>(_fields[I]); }
+		template <uint32_t I>
+		inline const field_type<I>* field() const { return static_cast<const field_type<I>*>(_fields[I]); }
+		template <uint32_t I>
+		inline Span<field_type<I>> span() { Span<field_type<I>> s = { field<I>(), _size }; return s; }
+		template <uint32_t I>
+		inline Span<const field_type<I>> span() const { Span<const field_type<I>> s = { field<I>(), _size }; return s; }
+
+		// Per element access
+		template <uint32_t I>
+		inline field_type<I>& get(uint32_t index) { return field<I>()[index]; }
+		template <uint32_t I>
+		inline const field_type<I>& get(uint32_t index) const { return field<I>()[index]; }
+
+	private:
+		template <uint32_t I>
+		inline void store(uint32_t) {}
+		template <uint32_t I, typename T, typename... Rest>
+		inline void store(uint32_t index, const T& value, const Rest&... rest);
+
+		// Forbidden, the container owns its allocation
+		SoAVector(const SoAVector&);
+		void operator=(const SoAVector&);
+
+	private:
+		static const size_t _field_sizes[sizeof...(Ts)];
+		static const size_t _field_alignments[sizeof...(Ts)];
+
+		void* _data;
+		void* _fields[sizeof...(Ts)];
+		uint32_t _size;
+		uint32_t _capacity;
+
+	public:
+		IAllocator* _allocator;
+	};
+}
+
+#include "soa_vector.inl"
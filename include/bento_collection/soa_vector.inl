@@ -0,0 +1,141 @@
+
+namespace bento
+{
+	template <typename... Ts>
+	const size_t SoAVector<Ts...>::_field_sizes[sizeof...(Ts)] = { sizeof(Ts)... };
+
+	template <typename... Ts>
+	const size_t SoAVector<Ts...>::_field_alignments[sizeof...(Ts)] = { (alignof(Ts) > CACHE_LINE_SIZE ? alignof(Ts) : CACHE_LINE_SIZE)... };
+
+	template <typename... Ts>
+	SoAVector<Ts...>::SoAVector(IAllocator& allocator)
+	: _data(nullptr)
+	, _size(0)
+	, _capacity(0)
+	, _allocator(&allocator)
+	{
+		memset(_fields, 0, sizeof(_fields));
+	}
+
+	template <typename... Ts>
+	SoAVector<Ts...>::SoAVector(IAllocator& allocator, uint32_t size)
+	: _data(nullptr)
+	, _size(0)
+	, _capacity(0)
+	, _allocator(&allocator)
+	{
+		memset(_fields, 0, sizeof(_fields));
+		resize(size);
+	}
+
+	template <typename... Ts>
+	SoAVector<Ts...>::~SoAVector()
+	{
+		free();
+	}
+
+	template <typename... Ts>
+	void SoAVector<Ts...>::resize(uint32_t size)
+	{
+		// Grow geometrically so that resizing one element at a time does not move the arrays every time
+		if (size > _capacity)
+		{
+			uint32_t space = size - _capacity;
+			uint32_t max_space = UINT32_MAX - _capacity;
+			space = space > _capacity ? space : (_capacity < max_space ? _capacity : max_space);
+			reserve(space);
+		}
+		_size = size;
+	}
+
+	template <typename... Ts>
+	void SoAVector<Ts...>::reserve(uint32_t space)
+	{
+		// Lay the arrays out one after the other, each one aligned on its own boundary
+		uint32_t new_capacity = _capacity + space;
+		size_t offsets[sizeof...(Ts)];
+		size_t total_size = 0;
+		size_t max_alignment = 0;
+		for (uint32_t field_idx = 0; field_idx < num_fields; ++field_idx)
+		{
+			size_t alignment = _field_alignments[field_idx];
+			total_size = (total_size + alignment - 1) & ~(alignment - 1);
+			offsets[field_idx] = total_size;
+			total_size += _field_sizes[field_idx] * new_capacity;
+			max_alignment = alignment > max_alignment ? alignment : max_alignment;
+		}
+
+		// Move the existing elements in the new allocation
+		char* data = (char*)_allocator->allocate(total_size, max_alignment);
+		for (uint32_t field_idx = 0; field_idx < num_fields; ++field_idx)
+		{
+			void* field_data = data + offsets[field_idx];
+			if (_size)
+				memcpy(field_data, _fields[field_idx], _field_sizes[field_idx] * _size);
+			_fields[field_idx] = field_data;
+		}
+
+		if (_data != nullptr)
+			_allocator->deallocate(_data);
+		_data = data;
+		_capacity = new_capacity;
+	}
+
+	template <typename... Ts>
+	void SoAVector<Ts...>::clear()
+	{
+		_size = 0;
+	}
+
+	template <typename... Ts>
+	void SoAVector<Ts...>::free()
+	{
+		if (_data != nullptr)
+		{
+			_allocator->deallocate(_data);
+			_data = nullptr;
+			memset(_fields, 0, sizeof(_fields));
+		}
+		_size = 0;
+		_capacity = 0;
+	}
+
+	template <typename... Ts>
+	void SoAVector<Ts...>::push_back(const Ts&... values)
+	{
+		uint32_t index = extend();
+		store<0>(index, values...);
+	}
+
+	template <typename... Ts>
+	uint32_t SoAVector<Ts...>::extend()
+	{
+		if (_size == _capacity)
+			reserve(_capacity * 2 + 10);
+		return _size++;
+	}
+
+	template <typename... Ts>
+	void SoAVector<Ts...>::remove_swap(uint32_t index)
+	{
+		uint32_t last_idx = _size - 1;
+		if (index != last_idx)
+		{
+			for (uint32_t field_idx = 0; field_idx < num_fields; ++field_idx)
+			{
+				char* field_data = (char*)_fields[field_idx];
+				size_t field_size = _field_sizes[field_idx];
+				memcpy(field_data + index * field_size, field_data + last_idx * field_size, field_size);
+			}
+		}
+		_size = last_idx;
+	}
+
+	template <typename... Ts>
+	template <uint32_t I, typename T, typename... Rest>
+	void SoAVector<Ts...>::store(uint32_t index, const T& value, const Rest&... rest)
+	{
+		field<I>()[index] = value;
+		store<I + 1>(index, rest...);
+	}
+}
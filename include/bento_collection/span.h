@@ -0,0 +1,24 @@
+#pragma once
+
+// Library includes
+#include "bento_base/platform.h"
+
+namespace bento {
+
+	// Non owning view on a contiguous array of elements
+	template <typename T>
+	struct Span
+	{
+		// Type definition
+		typedef T* iterator;
+		typedef const T* const_iterator;
+
+		T* data;
+		uint32_t size;
+
+		// Accessors
+		inline T& operator[](uint32_t index) const { return data[index]; }
+		inline iterator begin() const { return data; }
+		inline iterator end() const { return data + size; }
+	};
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+// Library includes
+#include "bento_base/platform.h"
+#include "bento_base/security.h"
+#include "bento_memory/common.h"
+#include "bento_collection/span.h"
+
+// External includes
+#include <atomic>
+#include <type_traits>
+
+namespace bento {
+
+	// Wait-free ring buffer for exactly one producer thread and one consumer thread.
+	// Elements are moved with memcpy, the type must be trivially copyable.
+	template <typename T>
+	class SPSCRing
+	{
+	public:
+		ALLOCATOR_BASED;
+		static_assert(std::is_trivially_copyable<T>::value, "SPSCRing elements must be trivially copyable");
+
+		// Cst & Dst (the capacity is rounded up to a power of two, 2^31 at most)
+		SPSCRing(IAllocator& allocator, uint32_t capacity);
+		~SPSCRing();
+
+		// Producer side: single and batch pushes (the batch returns the number of elements written)
+		bool try_push(const T& value);
+		uint32_t push(const T* values, uint32_t count);
+
+		// Producer side: zero-copy access to up to count free elements (the span stops at the end of the ring)
+		Span<T> reserve_write(uint32_t count);
+		void commit_write(uint32_t count);
+		uint32_t available_write();
+
+		// Consumer side: single and batch pops (the batch returns the number of elements read)
+		bool try_pop(T& value);
+		uint32_t pop(T* values, uint32_t max_count);
+
+		// Consumer side: zero-copy access to the readable elements (the span stops at the end of the ring)
+		Span<const T> reserve_read();
+		void commit_read(uint32_t count);
+		uint32_t available_read();
+
+		// Accessors
+		inline uint32_t capacity() const { return _mask + 1; }
+
+	private:
+		// Non copyable
+		SPSCRing(const SPSCRing&);
+		SPSCRing& operator=(const SPSCRing&);
+
+	private:
+		T* _data;
+		uint32_t _mask;
+		IAllocator& _allocator;
+
+		// Producer data, the consumer position is cached to avoid reading the shared one every time
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> _write_pos;
+		uint32_t _cached_read_pos;
+
+		// Consumer data, the producer position is cached to avoid reading the shared one every time
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> _read_pos;
+		uint32_t _cached_write_pos;
+		char _padding[CACHE_LINE_SIZE - sizeof(std::atomic<uint32_t>) - sizeof(uint32_t)];
+	};
+
+	// Single producer single consumer ring of variable length byte frames, every frame is contiguous in memory
+	class SPSCFrameRing
+	{
+	public:
+		ALLOCATOR_BASED;
+		// Cst
+		SPSCFrameRing(IAllocator& allocator, uint32_t capacity);
+
+		// Largest frame the ring accepts, half of the capacity so that a frame always fits once the ring is drained
+		inline uint32_t max_frame_size() const { return _ring.capacity() / 2 - (uint32_t)sizeof(uint32_t); }
+
+		// Producer side: reserve a frame and write it in place (nullptr if there is not enough space or if it is larger
+		// than max_frame_size), then commit it
+		char* reserve_frame(uint32_t size);
+		void commit_frame();
+
+		// Producer side: copy a whole frame
+		bool write_frame(const void* data, uint32_t size);
+
+		// Consumer side: access the next frame (nullptr if there is none), then release it
+		const char* read_frame(uint32_t& size);
+		void release_frame();
+
+	private:
+		SPSCRing<char> _ring;
+		uint32_t _pending_write;
+		uint32_t _pending_read;
+	};
+}
+
+#include "spsc_ring.inl"
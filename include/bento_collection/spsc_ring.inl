@@ -0,0 +1,155 @@
+
+namespace bento
+{
+	template <typename T>
+	SPSCRing<T>::SPSCRing(IAllocator& allocator, uint32_t capacity)
+	: _data(nullptr)
+	, _mask(0)
+	, _allocator(allocator)
+	, _write_pos(0)
+	, _cached_read_pos(0)
+	, _read_pos(0)
+	, _cached_write_pos(0)
+	{
+		// Round the capacity to the next power of two, the positions are 32 bits so it can't go above 2^31
+		assert_msg(capacity <= (1u << 31), "The capacity of the ring is too large");
+		capacity = capacity <= (1u << 31) ? capacity : (1u << 31);
+		uint32_t num_elements = 2;
+		while (num_elements < capacity)
+			num_elements *= 2;
+		_mask = num_elements - 1;
+		_data = static_cast<T*>(_allocator.allocate(sizeof(T) * num_elements, CACHE_LINE_SIZE));
+	}
+
+	template <typename T>
+	SPSCRing<T>::~SPSCRing()
+	{
+		_allocator.deallocate(_data);
+	}
+
+	template <typename T>
+	uint32_t SPSCRing<T>::available_write()
+	{
+		_cached_read_pos = _read_pos.load(std::memory_order_acquire);
+		return capacity() - (_write_pos.load(std::memory_order_relaxed) - _cached_read_pos);
+	}
+
+	template <typename T>
+	Span<T> SPSCRing<T>::reserve_write(uint32_t count)
+	{
+		// Only refresh the consumer position when the cached one says there is not enough space
+		uint32_t write_pos = _write_pos.load(std::memory_order_relaxed);
+		uint32_t free_elements = capacity() - (write_pos - _cached_read_pos);
+		if (free_elements < count)
+		{
+			_cached_read_pos = _read_pos.load(std::memory_order_acquire);
+			free_elements = capacity() - (write_pos - _cached_read_pos);
+		}
+
+		// The span cannot wrap around the end of the ring
+		uint32_t first_idx = write_pos & _mask;
+		uint32_t until_end = capacity() - first_idx;
+		Span<T> span;
+		span.data = _data + first_idx;
+		span.size = count < free_elements ? count : free_elements;
+		span.size = span.size < until_end ? span.size : until_end;
+		return span;
+	}
+
+	template <typename T>
+	void SPSCRing<T>::commit_write(uint32_t count)
+	{
+		_write_pos.store(_write_pos.load(std::memory_order_relaxed) + count, std::memory_order_release);
+	}
+
+	template <typename T>
+	bool SPSCRing<T>::try_push(const T& value)
+	{
+		Span<T> span = reserve_write(1);
+		if (span.size == 0)
+			return false;
+		*span.data = value;
+		commit_write(1);
+		return true;
+	}
+
+	template <typename T>
+	uint32_t SPSCRing<T>::push(const T* values, uint32_t count)
+	{
+		// At most two copies are needed when the batch wraps around the end of the ring
+		uint32_t written = 0;
+		for (uint32_t copy_idx = 0; copy_idx < 2 && written < count; ++copy_idx)
+		{
+			Span<T> span = reserve_write(count - written);
+			if (span.size == 0)
+				break;
+			memcpy(span.data, values + written, sizeof(T) * span.size);
+			commit_write(span.size);
+			written += span.size;
+		}
+		return written;
+	}
+
+	template <typename T>
+	uint32_t SPSCRing<T>::available_read()
+	{
+		_cached_write_pos = _write_pos.load(std::memory_order_acquire);
+		return _cached_write_pos - _read_pos.load(std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	Span<const T> SPSCRing<T>::reserve_read()
+	{
+		// Only refresh the producer position when the cached one says we are empty
+		uint32_t read_pos = _read_pos.load(std::memory_order_relaxed);
+		uint32_t num_elements = _cached_write_pos - read_pos;
+		if (num_elements == 0)
+		{
+			_cached_write_pos = _write_pos.load(std::memory_order_acquire);
+			num_elements = _cached_write_pos - read_pos;
+		}
+
+		// The span cannot wrap around the end of the ring
+		uint32_t first_idx = read_pos & _mask;
+		uint32_t until_end = capacity() - first_idx;
+		Span<const T> span;
+		span.data = _data + first_idx;
+		span.size = num_elements < until_end ? num_elements : until_end;
+		return span;
+	}
+
+	template <typename T>
+	void SPSCRing<T>::commit_read(uint32_t count)
+	{
+		_read_pos.store(_read_pos.load(std::memory_order_relaxed) + count, std::memory_order_release);
+	}
+
+	template <typename T>
+	bool SPSCRing<T>::try_pop(T& value)
+	{
+		Span<const T> span = reserve_read();
+		if (span.size == 0)
+			return false;
+		value = *span.data;
+		commit_read(1);
+		return true;
+	}
+
+	template <typename T>
+	uint32_t SPSCRing<T>::pop(T* values, uint32_t max_count)
+	{
+		// At most two copies are needed when the batch wraps around the end of the ring
+		uint32_t read = 0;
+		for (uint32_t copy_idx = 0; copy_idx < 2 && read < max_count; ++copy_idx)
+		{
+			Span<const T> span = reserve_read();
+			uint32_t copy_size = span.size < max_count - read ? span.size : max_count - read;
+			if (copy_size == 0)
+				break;
+			memcpy(values + read, span.data, sizeof(T) * copy_size);
+			commit_read(copy_size);
+			read += copy_size;
+		}
+		return read;
+	}
+}
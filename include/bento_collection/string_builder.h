@@ -0,0 +1,58 @@
+#pragma once
+
+// Library includes
+#include "bento_collection/dynamic_string.h"
+
+namespace bento {
+
+	// Header of a block of characters, the characters are stored right after it
+	struct StringBuilderBlock;
+
+	// Builds large strings by appending into linked blocks, nothing is copied until the string is flushed or finalized
+	class StringBuilder
+	{
+	public:
+		ALLOCATOR_BASED;
+		// Cst & Dst
+		StringBuilder(IAllocator& allocator);
+		StringBuilder(IAllocator& allocator, uint32_t block_size);
+		~StringBuilder();
+
+		// Append raw characters
+		void append(const char* str, uint32_t str_size);
+		void append(const StringView& str);
+		void append(char character);
+
+		// Append formatted numbers (the floats are written in fixed-point with at most 100 decimals)
+		void append_uint(uint64_t value);
+		void append_int(int64_t value);
+		void append_float(double value, uint32_t precision = 6);
+
+		// Total number of characters
+		inline uint64_t size() const { return _size; }
+
+		// Drop the content (the first block is kept for the next appends)
+		void clear();
+
+		// Write the content to a file descriptor and clear the builder, on failure only the unwritten content is kept
+		bool flush_to(int file_descriptor);
+
+		// Copy the content to a single contiguous string
+		void finalize(DynamicString& output) const;
+
+	private:
+		char* reserve_characters(uint32_t num_chars);
+		void append_block(uint32_t min_capacity);
+
+		// Non copyable
+		StringBuilder(const StringBuilder&);
+		StringBuilder& operator=(const StringBuilder&);
+
+	private:
+		StringBuilderBlock* _first;
+		StringBuilderBlock* _last;
+		uint32_t _block_size;
+		uint64_t _size;
+		IAllocator& _allocator;
+	};
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+// Library includes
+#include "bento_collection/string_view.h"
+#include "bento_base/hash.h"
+
+namespace bento {
+
+	// Handle on an interned string, it matches murmur_hash_64 of the string's content with a 0 seed
+	typedef uint64_t StringId;
+	const StringId INVALID_STRING_ID = UINT64_MAX;
+
+	// Global and thread safe table that stores every interned string once
+	namespace string_table
+	{
+		// Computes the id of a string without interning it
+		StringId string_id(const StringView& str);
+
+		// Interns a string and returns its id (INVALID_STRING_ID if it collides with an other string)
+		StringId intern(const StringView& str);
+
+		// Returns the interned string of an id (empty if the id is unknown), the view is null terminated and never invalidated
+		StringView resolve(StringId id);
+
+		// Returns the number of strings that have been interned
+		uint32_t num_strings();
+
+		// Compile time version of string_id (for literals)
+		constexpr StringId string_id(const char* str, uint32_t size)
+		{
+			return murmur_hash_64_constexpr(str, size, 0);
+		}
+	}
+
+	namespace literals
+	{
+		// "mesh/rock"_id is evaluated at compile time and matches string_table::string_id
+		constexpr StringId operator"" _id(const char* str, size_t size)
+		{
+			return string_table::string_id(str, (uint32_t)size);
+		}
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// Library includes
+#include "bento_base/platform.h"
+
+namespace bento {
+
+	// Non-owning view on a sequence of characters, the viewed data is not guaranteed to be null terminated
+	class StringView
+	{
+	public:
+		// Cst
+		StringView() : _data(""), _size(0) {}
+		StringView(const char* str) : _data(str), _size((uint32_t)strlen(str)) {}
+		StringView(const char* str, uint32_t str_size) : _data(str), _size(str_size) {}
+
+		// Accessors
+		inline const char* data() const { return _data; }
+		inline uint32_t size() const { return _size; }
+		inline bool empty() const { return _size == 0; }
+		inline char operator[](uint32_t index) const { return _data[index]; }
+
+		// Iterator access
+		inline const char* begin() const { return _data; }
+		inline const char* end() const { return _data + _size; }
+
+		// Comparison operators (the size is checked first)
+		inline bool operator==(const StringView& str) const { return _size == str._size && memcmp(_data, str._data, _size) == 0; }
+		inline bool operator!=(const StringView& str) const { return !((*this) == str); }
+
+	private:
+		const char* _data;
+		uint32_t _size;
+	};
+}
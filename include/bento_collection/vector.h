@@ -2,15 +2,18 @@
 
 // Library includes
 #include "bento_base/platform.h"
+#include "bento_base/security.h"
 #include "bento_memory/common.h"
 
 // External includes
 #include <type_traits>
+#include <stdlib.h>
 #include <string.h>
 
 namespace bento {
 	
-	template <typename T>
+	// Dynamic array, the size type can be widened to 64 bits for arrays that go past 4 billion elements
+	template <typename T, typename TSize = uint32_t>
 	class Vector
 	{
 	public:
@@ -31,17 +34,17 @@ namespace bento {
 		Vector(NoAllocator&);
 
 		// Size aware constructor
-		Vector(IAllocator& allocator, uint32_t size);
+		Vector(IAllocator& allocator, TSize size);
 
 		// Dst
 		~Vector();
 
 		// Accessors
-		inline uint32_t size() const {return _size;}
-		inline uint32_t capacity() const {return _capacity;}
+		inline TSize size() const {return _size;}
+		inline TSize capacity() const {return _capacity;}
 
-		// Resize the array
-		void resize(uint32_t size);
+		// Resize the array (left unchanged if the size does not fit in memory or in TSize)
+		void resize(TSize size);
 
 		// Free the memory
 		void free();
@@ -49,26 +52,26 @@ namespace bento {
 		// set the size to 0
 		void clear();
 
-		// Reserve memory in the array
-		void reserve(uint32_t _space);
+		// Reserve memory for _space more elements, returns false if the capacity would not fit in memory or in TSize
+		bool reserve(TSize _space);
 
 		// Copy operator
-		void operator=(const Vector<T>& vec);
+		void operator=(const Vector<T, TSize>& vec);
 
-		inline reference operator[](uint32_t index)
+		inline reference operator[](TSize index)
 		{
 			return _data[index];
 		}
 
-		inline const_reference operator[] (uint32_t index) const
+		inline const_reference operator[] (TSize index) const
 		{
 			return _data[index];
 		}
 
-		// Append an element in the vector
+		// Append an element in the vector (dropped if the capacity can't grow)
 		void push_back(const T& _value);
 
-		// Creates a new element and returns a pointer to it
+		// Creates a new element and returns a pointer to it (fatal if the capacity can't grow)
 		reference extend();
 
 		// Iterator access
@@ -77,17 +80,24 @@ namespace bento {
 		inline iterator end() {return _data + _size;}
 		inline const_iterator end() const {return _data + _size;}
 	private:
+		// Grow the capacity by at least min_space, doubling it when possible
+		bool grow(TSize min_space);
+
 		void construct(pointer p, const Int2Type<true> &) { new (p) T(*_allocator); }
 		void construct(pointer p, const Int2Type<false> &) { new (p) T(); }
 
 	protected:
 		T* _data;
-		uint32_t _size;
-		uint32_t _capacity;
+		TSize _size;
+		TSize _capacity;
 
 	public:
 		IAllocator* _allocator;
 	};
+
+	// Vector with a 64 bit size and capacity
+	template <typename T>
+	using Vector64 = Vector<T, uint64_t>;
 }
 
 #include "vector.inl"
\ No newline at end of file
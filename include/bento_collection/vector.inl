@@ -1,8 +1,8 @@
 
 namespace bento
 {
-	template <typename T>
-	Vector<T>::Vector(IAllocator& allocator)
+	template <typename T, typename TSize>
+	Vector<T, TSize>::Vector(IAllocator& allocator)
 	: _allocator(&allocator)
 	, _size(0)
 	, _capacity(0)
@@ -11,8 +11,8 @@ namespace bento
 
 	}
 
-	template <typename T>
-	Vector<T>::Vector(NoAllocator&)
+	template <typename T, typename TSize>
+	Vector<T, TSize>::Vector(NoAllocator&)
 	: _allocator(nullptr)
 	, _size(0)
 	, _capacity(0)
@@ -21,8 +21,8 @@ namespace bento
 
 	}
 
-	template <typename T>
-	Vector<T>::Vector(IAllocator& allocator, uint32_t size)
+	template <typename T, typename TSize>
+	Vector<T, TSize>::Vector(IAllocator& allocator, TSize size)
 	: _allocator(&allocator)
 	, _size(0)
 	, _capacity(0)
@@ -31,14 +31,14 @@ namespace bento
 		resize(size);
 	}
 
-	template <typename T>
-	Vector<T>::~Vector()
+	template <typename T, typename TSize>
+	Vector<T, TSize>::~Vector()
 	{
 		free();
 	}
 
-	template <typename T>
-	void Vector<T>::resize(uint32_t size)
+	template <typename T, typename TSize>
+	void Vector<T, TSize>::resize(TSize size)
 	{
 		if(size ==  0)
 		{
@@ -49,7 +49,7 @@ namespace bento
 			if(!std::is_trivially_constructible<T>())
 			{
 				// Extra elements in the vector remove them
-				for(uint32_t ele_idx = size; ele_idx < _size; ++ele_idx)
+				for(TSize ele_idx = size; ele_idx < _size; ++ele_idx)
 				{
 					_data[ele_idx].~T();
 				}
@@ -57,12 +57,12 @@ namespace bento
 
 			_size = size;
 		}
-		else if (size < _capacity)
+		else if (size <= _capacity)
 		{
 			if(!std::is_trivially_constructible<T>())
 			{
 				// Enough capacity to handle this, construct the new elements
-				for(uint32_t ele_idx = _size; ele_idx < size; ++ele_idx)
+				for(TSize ele_idx = _size; ele_idx < size; ++ele_idx)
 				{
 					construct(&_data[ele_idx], IS_ALLOCATOR_BASED_TYPE(T)());
 				}
@@ -72,10 +72,11 @@ namespace bento
 		else
 		{
 			// We need to increase our capacity, it is not big enough
-			reserve(size);
+			if (!grow(size - _capacity))
+				return;
 			if(!std::is_trivially_constructible<T>())
 			{
-				for(uint32_t ele_idx = _size; ele_idx < size; ++ele_idx)
+				for(TSize ele_idx = _size; ele_idx < size; ++ele_idx)
 				{
 					construct(&_data[ele_idx], IS_ALLOCATOR_BASED_TYPE(T)());
 				}
@@ -84,12 +85,12 @@ namespace bento
 		}
 	}
 
-	template <typename T>
-	void Vector<T>::clear()
+	template <typename T, typename TSize>
+	void Vector<T, TSize>::clear()
 	{
 		if(!std::is_trivially_constructible<T>())
 		{
-			for(uint32_t ele_idx = 0; ele_idx < _size; ++ele_idx)
+			for(TSize ele_idx = 0; ele_idx < _size; ++ele_idx)
 			{
 				_data[ele_idx].~T();
 			}
@@ -97,8 +98,8 @@ namespace bento
 		_size = 0;
 	}
 
-	template <typename T>
-	void Vector<T>::free()
+	template <typename T, typename TSize>
+	void Vector<T, TSize>::free()
 	{
 		if(_capacity)
 		{
@@ -109,10 +110,18 @@ namespace bento
 		}
 	}
 
-	template <typename T>
-	void Vector<T>::reserve(uint32_t size)
+	template <typename T, typename TSize>
+	bool Vector<T, TSize>::reserve(TSize size)
 	{
-		size_t allocCount = (size_t)(_capacity + size);
+		// The largest capacity must fit both in TSize and in the byte size of the allocation
+		uint64_t max_count = (uint64_t)(TSize)~(TSize)0;
+		max_count = max_count < SIZE_MAX / sizeof(T) ? max_count : SIZE_MAX / sizeof(T);
+		if ((uint64_t)size > max_count - (uint64_t)_capacity)
+		{
+			assert_fail_msg("The capacity does not fit in the size type of the vector");
+			return false;
+		}
+		size_t allocCount = (size_t)_capacity + (size_t)size;
 		void* ptr = _allocator->allocate(sizeof(T) * allocCount, 4);
 		memcpy(ptr, _data, sizeof(T) * _size);
 		if(_data != nullptr)
@@ -120,16 +129,35 @@ namespace bento
 			_allocator->deallocate(_data);
 		}
 		_data = static_cast<T*>(ptr);
-		_capacity = (_capacity + size);
+		_capacity = (TSize)allocCount;
+		return true;
+	}
+
+	template <typename T, typename TSize>
+	bool Vector<T, TSize>::grow(TSize min_space)
+	{
+		// Ask for max(min_space, _capacity, 10) more elements, clamped so the sum can't overflow
+		uint64_t max_count = (uint64_t)(TSize)~(TSize)0;
+		max_count = max_count < SIZE_MAX / sizeof(T) ? max_count : SIZE_MAX / sizeof(T);
+		uint64_t max_space = max_count - (uint64_t)_capacity;
+		uint64_t space = (uint64_t)(_capacity > min_space ? _capacity : min_space);
+		space = space > 10 ? space : 10;
+		space = space < max_space ? space : max_space;
+		if (space < (uint64_t)min_space || space == 0)
+		{
+			assert_fail_msg("The capacity does not fit in the size type of the vector");
+			return false;
+		}
+		return reserve((TSize)space);
 	}
 
 
-	template <typename T>
-	void Vector<T>::push_back(const T& _value)
+	template <typename T, typename TSize>
+	void Vector<T, TSize>::push_back(const T& _value)
 	{
-		if(_size == _capacity)
+		if(_size == _capacity && !grow(1))
 		{
-			reserve(_capacity * 2 + 10);
+			return;
 		}
 		
 		if(!std::is_trivially_constructible<T>())
@@ -145,24 +173,27 @@ namespace bento
 	}
 
 	// Copy operator
-	template <typename T>
-	void Vector<T>::operator=(const Vector<T>& vec)
+	template <typename T, typename TSize>
+	void Vector<T, TSize>::operator=(const Vector<T, TSize>& vec)
 	{
-		uint32_t final_size = vec.size();
+		TSize final_size = vec.size();
 		resize(final_size);
-		for(uint32_t ele_idx = 0; ele_idx < final_size; ++ele_idx)
+		if (_size != final_size)
+			return;
+		for(TSize ele_idx = 0; ele_idx < final_size; ++ele_idx)
 		{
 			_data[ele_idx] = vec[ele_idx];
 		}
 	}
 
 	// Creates a new element and returns a pointer to it
-	template <typename T>
-	T& Vector<T>::extend()
+	template <typename T, typename TSize>
+	T& Vector<T, TSize>::extend()
 	{
-		if (_size == _capacity)
+		// There is no element to return if the capacity can't grow
+		if (_size == _capacity && !grow(1))
 		{
-			reserve(_capacity * 2 + 10);
+			abort();
 		}
 
 		if (!std::is_trivially_constructible<T>())
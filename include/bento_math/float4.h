@@ -27,39 +27,39 @@ namespace bento {
 	float4 build_float4(float x, float y, float z, float w);
 
 	// Direct access to elements
-	__forceinline float& element(float4& v, uint32_t i);
-	__forceinline const float& element(const float4& v, uint32_t i);
-	__forceinline float x_element(float4 v);
-	__forceinline float y_element(float4 v);
-	__forceinline float z_element(float4 v);
-	__forceinline float w_element(float4 v);
+	bento_forceinline float& element(float4& v, uint32_t i);
+	bento_forceinline const float& element(const float4& v, uint32_t i);
+	bento_forceinline float x_element(float4 v);
+	bento_forceinline float y_element(float4 v);
+	bento_forceinline float z_element(float4 v);
+	bento_forceinline float w_element(float4 v);
 
 	// Operators
-	__forceinline float4 operator+ (const float4& a, const float4& b);
-	__forceinline float4 operator- (const float4& a, const float4& b);
-	__forceinline float4 operator* (const float4& a, const float4& b);
-	__forceinline float4 operator/ (const float4& a, const float4& b);
-	__forceinline float4 operator* (const float4& a, float b);
-	__forceinline float4 operator/ (const float4& a, float b);
-	__forceinline float4 operator* (float a, const float4& b);
-	__forceinline float4 operator/ (float a, const float4& b);
-	__forceinline float4& operator+= (float4 &a, const float4& b);
-	__forceinline float4& operator-= (float4 &a, const float4& b);
-	__forceinline float4& operator*= (float4 &a, const float4& b);
-	__forceinline float4& operator/= (float4 &a, const float4& b);
-	__forceinline float4& operator*= (float4 &a, float b);
-	__forceinline float4& operator/= (float4 &a, float b);
-	__forceinline float4 operator==(const float4& a, const float4& b);
-	__forceinline float4 operator!=(float4 a, const float4& b);
-	__forceinline float4 operator< (const float4& a, const float4& b);
-	__forceinline float4 operator> (const float4& a, const float4& b);
-	__forceinline float4 operator<=(const float4& a, const float4& b);
-	__forceinline float4 operator>=(const float4& a, const float4& b);
-	__forceinline float4 min(float4 a, float4 b);
-	__forceinline float4 max(float4 a, float4 b);
+	bento_forceinline float4 operator+ (const float4& a, const float4& b);
+	bento_forceinline float4 operator- (const float4& a, const float4& b);
+	bento_forceinline float4 operator* (const float4& a, const float4& b);
+	bento_forceinline float4 operator/ (const float4& a, const float4& b);
+	bento_forceinline float4 operator* (const float4& a, float b);
+	bento_forceinline float4 operator/ (const float4& a, float b);
+	bento_forceinline float4 operator* (float a, const float4& b);
+	bento_forceinline float4 operator/ (float a, const float4& b);
+	bento_forceinline float4& operator+= (float4 &a, const float4& b);
+	bento_forceinline float4& operator-= (float4 &a, const float4& b);
+	bento_forceinline float4& operator*= (float4 &a, const float4& b);
+	bento_forceinline float4& operator/= (float4 &a, const float4& b);
+	bento_forceinline float4& operator*= (float4 &a, float b);
+	bento_forceinline float4& operator/= (float4 &a, float b);
+	bento_forceinline float4 operator==(const float4& a, const float4& b);
+	bento_forceinline float4 operator!=(float4 a, const float4& b);
+	bento_forceinline float4 operator< (const float4& a, const float4& b);
+	bento_forceinline float4 operator> (const float4& a, const float4& b);
+	bento_forceinline float4 operator<=(const float4& a, const float4& b);
+	bento_forceinline float4 operator>=(const float4& a, const float4& b);
+	bento_forceinline float4 min(float4 a, float4 b);
+	bento_forceinline float4 max(float4 a, float4 b);
 
-	__forceinline float min_xyz(float4 v);
-	__forceinline float max_xyz(float4 v);
+	bento_forceinline float min_xyz(float4 v);
+	bento_forceinline float max_xyz(float4 v);
 }
 
 #include "float4.inl"
@@ -2,7 +2,11 @@
 
 // Bento includes
 #include <bento_collection/dynamic_string.h>
+#include <bento_collection/string_table.h>
+#include <bento_collection/flat_map.h>
+#include <bento_collection/chunked_vector.h>
 #include <bento_base/hash.h>
+#include <bento_base/stream.h>
 
 namespace bento
 {
@@ -10,17 +14,19 @@ namespace bento
 	{
 		ALLOCATOR_BASED;
 		TAsset(bento::IAllocator& alloc)
-		: name(alloc)
-		, path(alloc)
+		: id(INVALID_STRING_ID)
+		, path(INVALID_STRING_ID)
 		, type(UINT32_MAX)
 		, data(alloc)
-		, id(UINT64_MAX)
 		{
 		}
 
-		uint64_t				id;
-		bento::DynamicString	name;
-		bento::DynamicString	path;
+		// Name of the asset, resolved from its interned id
+		inline StringView name() const { return string_table::resolve(id); }
+
+		// Interned name of the asset (see string_table::resolve)
+		StringId				id;
+		StringId				path;
 		uint32_t				type;
 		bento::Vector<char>		data;
 	};
@@ -34,6 +40,9 @@ namespace bento
 		// Insert an asset into the database
 		void insert_asset(const char* name, const char* path, uint32_t resourceType, bento::Vector<char>& data);
 
+		// Rebuild the id index from the asset array
+		void build_index();
+
 		// Request an asset either using its name or id
 		const TAsset* request_asset(const char* name) const;
 		const TAsset* request_asset(uint64_t id) const;
@@ -42,8 +51,7 @@ namespace bento
 		bool unpack_asset_to_type(const char* name, T& outputType) const
 		{
 			// Hash and call the right model
-			uint64_t id = bento::murmur_hash_64(name, string::strlen32(name), 0);
-			return unpack_asset_to_type(id, outputType);
+			return unpack_asset_to_type(string_table::string_id(name), outputType);
 		}
 
 		template<typename T>
@@ -59,12 +67,18 @@ namespace bento
 		}
 
 	public:
-		bento::Vector<TAsset> _assets;
+		// Assets are never relocated, the pointers returned by request_asset stay valid
+		bento::ChunkedVector<TAsset> _assets;
+		// Index of the assets sorted by id (rebuilt at unpack time)
+		bento::FlatMap<uint64_t, uint32_t> _asset_index;
 		bento::IAllocator& allocator;
 	};
 
+	// The payload size is escaped like pack_count once it reaches 4GB, such databases need a 64 bit buffer
 	void pack_type(Vector<char>& buffer, const TAssetDatabase& database);
-	bool unpack_type(const char*& stream, TAssetDatabase& database);
+	void pack_type(Vector64<char>& buffer, const TAssetDatabase& database);
+	// Fails if the database is truncated or corrupted
+	bool unpack_type(StreamReader& reader, TAssetDatabase& database);
 
 	void to_string(DynamicString& str, const TAssetDatabase& database);
 }
\ No newline at end of file
@@ -72,6 +72,7 @@ namespace bento
 
 		// Serialization and Deserialization methods for the BVH
 		void pack(Vector<char>& v, const Bvh& b);
+		void pack(Vector64<char>& v, const Bvh& b);
 		void unpack(const char *& v, Bvh& b);
 	}
 }
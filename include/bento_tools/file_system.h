@@ -14,6 +14,13 @@ namespace bento {
 		DynamicString extension(const char *file, IAllocator& allocator);
 		DynamicString directory(const char *file, IAllocator& allocator);
 		DynamicString filename(const char *file, IAllocator& allocator);
+
+		// Allocation-free versions, the output string's memory is reused and the views point into the input
+		void join(const StringView& root, const StringView& sub_path, DynamicString& output);
+		StringView strip_extension(const StringView& file);
+		StringView extension(const StringView& file);
+		StringView directory(const StringView& file);
+		StringView filename(const StringView& file);
 	}
 
 	namespace file_system
@@ -32,6 +39,7 @@ namespace bento {
 		Text
 	};
 
-	bool write_file(const char *file_name, const char *buffer, uint32_t buffer_size, FileType type);
+	bool write_file(const char *file_name, const char *buffer, uint64_t buffer_size, FileType type);
 	bool read_file(const char *file_name, Vector<char>& buffer, FileType type);
+	bool read_file(const char *file_name, Vector64<char>& buffer, FileType type);
 }
\ No newline at end of file
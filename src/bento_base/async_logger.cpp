@@ -0,0 +1,126 @@
+// Library includes
+#include "bento_base/async_logger.h"
+#include "bento_base/system_logger.h"
+
+// External includes
+#include <chrono>
+
+namespace bento {
+
+	// Time the writer thread sleeps when there is nothing to write
+	const uint32_t ASYNC_LOGGER_IDLE_MS = 1;
+
+	AsyncLogger::AsyncLogger(IAllocator& allocator, uint32_t capacity, const char* file_path)
+	: _records(allocator, capacity)
+	, _output(stdout)
+	, _owns_output(false)
+	, _running(true)
+	, _pushed(0)
+	, _written(0)
+	, _dropped(0)
+	, _reported_dropped(0)
+	{
+		if (file_path != nullptr)
+		{
+			FILE* file = fopen(file_path, "w");
+			if (file != nullptr)
+			{
+				_output = file;
+				_owns_output = true;
+			}
+		}
+		_thread = std::thread(&AsyncLogger::drain, this);
+	}
+
+	AsyncLogger::~AsyncLogger()
+	{
+		// The writer thread empties the queue before leaving
+		_running.store(false, std::memory_order_release);
+		_thread.join();
+		if (_owns_output)
+			fclose(_output);
+	}
+
+	void AsyncLogger::push(const LogRecord& record)
+	{
+		if (_records.try_push(record))
+			_pushed.fetch_add(1, std::memory_order_release);
+		else
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void AsyncLogger::log(LogLevel::Type log_level, const char* tag, const char* message)
+	{
+		LogRecord record;
+		record.level = log_level;
+		record.new_line = false;
+		copy_truncated(record.tag, tag, LOG_RECORD_TAG_SIZE);
+		copy_truncated(record.message, message, LOG_RECORD_MESSAGE_SIZE);
+		push(record);
+	}
+
+	void AsyncLogger::new_line()
+	{
+		LogRecord record;
+		record.level = LogLevel::info;
+		record.new_line = true;
+		record.tag[0] = '\0';
+		record.message[0] = '\0';
+		push(record);
+	}
+
+	void AsyncLogger::flush()
+	{
+		// Wait for the writer thread to catch up with the records pushed before the call
+		uint64_t target = _pushed.load(std::memory_order_acquire);
+		while (_written.load(std::memory_order_acquire) < target)
+			std::this_thread::yield();
+	}
+
+	void AsyncLogger::write_record(const LogRecord& record)
+	{
+		if (record.new_line)
+			fputs("\n", _output);
+		else
+			fprintf(_output, "%s[%s]%s\n", level_to_string(record.level), record.tag, record.message);
+	}
+
+	void AsyncLogger::drain()
+	{
+		LogRecord record;
+		for (;;)
+		{
+			// Read the flag before emptying the queue, records pushed before the shutdown are never lost
+			bool running = _running.load(std::memory_order_acquire);
+			uint32_t num_written = 0;
+			while (_records.try_pop(record))
+			{
+				write_record(record);
+				++num_written;
+			}
+
+			// Report the records that could not be queued
+			uint64_t dropped = _dropped.load(std::memory_order_relaxed);
+			if (dropped != _reported_dropped)
+			{
+				fprintf(_output, "%s[LOGGER]%llu records dropped, the queue was full\n", level_to_string(LogLevel::warning), (unsigned long long)(dropped - _reported_dropped));
+				_reported_dropped = dropped;
+			}
+
+			if (num_written > 0)
+			{
+				fflush(_output);
+				_written.fetch_add(num_written, std::memory_order_release);
+			}
+			else if (!running)
+			{
+				break;
+			}
+			else
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(ASYNC_LOGGER_IDLE_MS));
+			}
+		}
+		fflush(_output);
+	}
+}
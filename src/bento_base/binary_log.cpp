@@ -0,0 +1,508 @@
+// Library includes
+#include "bento_base/binary_log.h"
+#include "bento_base/system_logger.h"
+#include "bento_base/stream.h"
+#include "bento_memory/common.h"
+
+// External includes
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+
+namespace bento {
+
+	// Record layout: site id (uint32), payload size (uint16), number of arguments (uint8), then the arguments.
+	// Each argument is its type (uint8) followed by its raw bytes (length prefixed for the strings).
+	const uint32_t BINARY_LOG_RECORD_HEADER_SIZE = 7;
+	const uint32_t BINARY_LOG_MAX_PAYLOAD_SIZE = UINT16_MAX;
+
+	// Longest conversion spec (flags, width and precision) the decoder accepts, the * are counted once replaced
+	const uint32_t BINARY_LOG_MAX_SPEC_SIZE = 24;
+
+	// Static description of a call site
+	struct BinaryLogSite
+	{
+		LogLevel::Type level;
+		uint32_t line;
+		const char* tag;
+		const char* format;
+		const char* file;
+	};
+
+	class BinaryLogRegistry
+	{
+	public:
+		BinaryLogRegistry(IAllocator& allocator)
+		: _sites(allocator)
+		{
+		}
+
+		uint32_t register_site(const BinaryLogSite& site)
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			uint32_t site_id = _sites.size();
+			_sites.push_back(site);
+			return site_id;
+		}
+
+		void dump(Vector<char>& output)
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			uint32_t num_sites = _sites.size();
+			pack_bytes(output, num_sites);
+			for (uint32_t site_idx = 0; site_idx < num_sites; ++site_idx)
+			{
+				const BinaryLogSite& site = _sites[site_idx];
+				pack_bytes(output, (uint32_t)site.level);
+				pack_bytes(output, site.line);
+				pack_string(output, site.tag);
+				pack_string(output, site.format);
+				pack_string(output, site.file);
+			}
+		}
+
+	private:
+		static void pack_string(Vector<char>& output, const char* str)
+		{
+			uint32_t length = str != nullptr ? (uint32_t)strlen(str) : 0;
+			pack_bytes(output, length);
+			pack_buffer(output, length, str);
+		}
+
+	private:
+		Vector<BinaryLogSite> _sites;
+		std::mutex _lock;
+	};
+
+	BinaryLogRegistry& binary_log_registry()
+	{
+		static BinaryLogRegistry __registry(*common_allocator());
+		return __registry;
+	}
+
+	// Global state of the binary logging
+	static std::atomic<uint64_t> __binary_log_dropped(0);
+	static binary_log::Sink __binary_log_sink = nullptr;
+	static void* __binary_log_sink_data = nullptr;
+
+	// Per-thread record buffer, allocated on the first record and flushed when the thread exits
+	struct BinaryLogThreadBuffer
+	{
+		BinaryLogThreadBuffer()
+		: data(nullptr)
+		, size(0)
+		{
+		}
+
+		~BinaryLogThreadBuffer()
+		{
+			if (data == nullptr)
+				return;
+			flush();
+			common_allocator()->deallocate(data);
+		}
+
+		void flush()
+		{
+			if (size != 0 && __binary_log_sink != nullptr)
+				__binary_log_sink(data, size, __binary_log_sink_data);
+			size = 0;
+		}
+
+		char* data;
+		uint32_t size;
+	};
+
+	static thread_local BinaryLogThreadBuffer __binary_log_buffer;
+
+	// Bounds checked reader used by the decoder
+	struct BinaryLogReader
+	{
+		const char* cursor;
+		const char* end;
+
+		template<typename T>
+		bool read(T& value)
+		{
+			if ((uint64_t)(end - cursor) < sizeof(T))
+				return false;
+			memcpy(&value, cursor, sizeof(T));
+			cursor += sizeof(T);
+			return true;
+		}
+
+		bool read_view(uint64_t size, const char*& data)
+		{
+			if ((uint64_t)(end - cursor) < size)
+				return false;
+			data = cursor;
+			cursor += size;
+			return true;
+		}
+	};
+
+	struct DecodedSite
+	{
+		uint32_t level;
+		uint32_t line;
+		StringView tag;
+		StringView format;
+		StringView file;
+	};
+
+	static bool read_string(BinaryLogReader& reader, StringView& str)
+	{
+		uint32_t length;
+		const char* data;
+		if (!reader.read(length) || !reader.read_view(length, data))
+			return false;
+		str = StringView(data, length);
+		return true;
+	}
+
+	static void append_view(DynamicString& output, const StringView& str)
+	{
+		output.append(str.data(), str.size());
+	}
+
+	// Default text of an argument, used when the format has no matching conversion
+	static void append_default(DynamicString& output, const binary_log::Arg& arg, const char* string_data)
+	{
+		char text[64];
+		switch (arg.type)
+		{
+			case binary_log::ArgType::int32:
+			case binary_log::ArgType::int64:
+				snprintf(text, sizeof(text), "%lld", (long long)arg.bits);
+				break;
+			case binary_log::ArgType::uint32:
+			case binary_log::ArgType::uint64:
+				snprintf(text, sizeof(text), "%llu", (unsigned long long)arg.bits);
+				break;
+			case binary_log::ArgType::real:
+			{
+				double value;
+				memcpy(&value, &arg.bits, sizeof(double));
+				snprintf(text, sizeof(text), "%g", value);
+				break;
+			}
+			case binary_log::ArgType::string:
+				output.append(string_data, arg.size);
+				return;
+			default:
+				snprintf(text, sizeof(text), "0x%llx", (unsigned long long)arg.bits);
+				break;
+		}
+		output += text;
+	}
+
+	// Format one argument with a printf conversion, the length modifiers come from the recorded type and not from the format
+	static void append_formatted(DynamicString& output, const char* spec, uint32_t spec_size, char conversion, const binary_log::Arg& arg, const char* string_data)
+	{
+		// The spec holds the flags, the width and the precision
+		char format[32];
+		char text[512];
+		bool is_integer = arg.type <= binary_log::ArgType::uint64;
+		bool is_wide = arg.type == binary_log::ArgType::int64 || arg.type == binary_log::ArgType::uint64;
+		memcpy(format, spec, spec_size);
+		uint32_t format_size = spec_size;
+
+		if (strchr("diuxXoc", conversion) != nullptr && is_integer)
+		{
+			if (is_wide && conversion != 'c')
+			{
+				format[format_size++] = 'l';
+				format[format_size++] = 'l';
+			}
+			format[format_size++] = conversion;
+			format[format_size] = '\0';
+			if (is_wide && conversion != 'c')
+				snprintf(text, sizeof(text), format, (long long)arg.bits);
+			else
+				snprintf(text, sizeof(text), format, (int)arg.bits);
+		}
+		else if (strchr("fFeEgGaA", conversion) != nullptr && (arg.type == binary_log::ArgType::real || is_integer))
+		{
+			double value;
+			if (arg.type == binary_log::ArgType::real)
+				memcpy(&value, &arg.bits, sizeof(double));
+			else if (arg.type == binary_log::ArgType::int32 || arg.type == binary_log::ArgType::int64)
+				value = (double)(int64_t)arg.bits;
+			else
+				value = (double)arg.bits;
+			format[format_size++] = conversion;
+			format[format_size] = '\0';
+			snprintf(text, sizeof(text), format, value);
+		}
+		else if (conversion == 's' && arg.type == binary_log::ArgType::string)
+		{
+			char str[binary_log::MAX_STRING_ARGUMENT_SIZE + 1];
+			memcpy(str, string_data, arg.size);
+			str[arg.size] = '\0';
+			format[format_size++] = 's';
+			format[format_size] = '\0';
+			snprintf(text, sizeof(text), format, str);
+		}
+		else if (conversion == 'p' && arg.type == binary_log::ArgType::pointer)
+		{
+			format[format_size++] = 'p';
+			format[format_size] = '\0';
+			snprintf(text, sizeof(text), format, (void*)(uintptr_t)arg.bits);
+		}
+		else
+		{
+			append_default(output, arg, string_data);
+			return;
+		}
+		output += text;
+	}
+
+	// Read the next recorded argument
+	static bool read_arg(BinaryLogReader& reader, binary_log::Arg& arg, const char*& string_data)
+	{
+		uint8_t type;
+		if (!reader.read(type))
+			return false;
+		arg.type = type;
+		if (type == binary_log::ArgType::int32 || type == binary_log::ArgType::uint32)
+		{
+			uint32_t value;
+			if (!reader.read(value))
+				return false;
+			arg.bits = type == binary_log::ArgType::int32 ? (uint64_t)(int64_t)(int32_t)value : value;
+			arg.size = 4;
+			return true;
+		}
+		if (type == binary_log::ArgType::string)
+		{
+			uint16_t length;
+			if (!reader.read(length) || length > binary_log::MAX_STRING_ARGUMENT_SIZE || !reader.read_view(length, string_data))
+				return false;
+			arg.size = length;
+			return true;
+		}
+		arg.size = 8;
+		return type <= binary_log::ArgType::pointer && reader.read(arg.bits);
+	}
+
+	// Decode the arguments of a record and write the formatted message
+	static bool decode_message(BinaryLogReader& reader, uint32_t num_args, const StringView& format, DynamicString& output)
+	{
+		const char* format_data = format.data();
+		uint32_t format_size = format.size();
+		uint32_t char_idx = 0;
+		uint32_t arg_idx = 0;
+		binary_log::Arg arg = { 0, 0, 0, nullptr };
+		const char* string_data = nullptr;
+		while (char_idx < format_size)
+		{
+			// Copy the format until the next conversion
+			char character = format_data[char_idx];
+			if (character != '%')
+			{
+				output.append(&character, 1);
+				++char_idx;
+				continue;
+			}
+			if (char_idx + 1 < format_size && format_data[char_idx + 1] == '%')
+			{
+				output.append("%", 1);
+				char_idx += 2;
+				continue;
+			}
+
+			// Extract the flags, width and precision (a * takes its value from the next argument), then skip the length modifiers
+			char spec[BINARY_LOG_MAX_SPEC_SIZE];
+			uint32_t spec_size = 0;
+			bool missing = false;
+			spec[spec_size++] = format_data[char_idx++];
+			while (char_idx < format_size && strchr("-+ #0123456789.*", format_data[char_idx]) != nullptr)
+			{
+				char text[16] = { format_data[char_idx++], '\0' };
+				if (text[0] == '*')
+				{
+					if (arg_idx == num_args)
+					{
+						missing = true;
+						continue;
+					}
+					if (!read_arg(reader, arg, string_data))
+						return false;
+					++arg_idx;
+					int value = arg.type <= binary_log::ArgType::uint64 ? (int)arg.bits : 0;
+
+					// A negative precision is ignored like printf does
+					if (value < 0 && spec[spec_size - 1] == '.')
+					{
+						--spec_size;
+						continue;
+					}
+					snprintf(text, sizeof(text), "%d", value);
+				}
+				uint32_t text_size = (uint32_t)strlen(text);
+				if (spec_size + text_size >= BINARY_LOG_MAX_SPEC_SIZE)
+					return false;
+				memcpy(spec + spec_size, text, text_size);
+				spec_size += text_size;
+			}
+			while (char_idx < format_size && strchr("hlLqjzt", format_data[char_idx]) != nullptr)
+				++char_idx;
+			char conversion = char_idx < format_size ? format_data[char_idx++] : 's';
+
+			if (missing || arg_idx == num_args)
+			{
+				output.append("<missing>", 9);
+				continue;
+			}
+			if (!read_arg(reader, arg, string_data))
+				return false;
+			++arg_idx;
+			append_formatted(output, spec, spec_size, conversion, arg, string_data);
+		}
+
+		// The arguments the format does not use are appended at the end
+		for (; arg_idx < num_args; ++arg_idx)
+		{
+			if (!read_arg(reader, arg, string_data))
+				return false;
+			output.append(" ", 1);
+			append_default(output, arg, string_data);
+		}
+		return true;
+	}
+
+	namespace binary_log
+	{
+		uint32_t register_site(LogLevel::Type log_level, const char* tag, const char* format, const char* file, uint32_t line)
+		{
+			BinaryLogSite site = { log_level, line, tag, format, file };
+			return binary_log_registry().register_site(site);
+		}
+
+		void set_sink(Sink sink, void* user_data)
+		{
+			__binary_log_sink = sink;
+			__binary_log_sink_data = user_data;
+		}
+
+		void write_record(uint32_t site_id, const Arg* args, uint32_t num_args)
+		{
+			uint32_t payload_size = 0;
+			for (uint32_t arg_idx = 0; arg_idx < num_args; ++arg_idx)
+				payload_size += 1 + args[arg_idx].size;
+			if (payload_size > BINARY_LOG_MAX_PAYLOAD_SIZE || num_args > UINT8_MAX || BINARY_LOG_RECORD_HEADER_SIZE + payload_size > THREAD_BUFFER_SIZE)
+			{
+				__binary_log_dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			// Make room in the thread buffer
+			BinaryLogThreadBuffer& buffer = __binary_log_buffer;
+			uint32_t record_size = BINARY_LOG_RECORD_HEADER_SIZE + payload_size;
+			if (buffer.data == nullptr)
+				buffer.data = (char*)common_allocator()->allocate(THREAD_BUFFER_SIZE, 16);
+			else if (buffer.size + record_size > THREAD_BUFFER_SIZE)
+				buffer.flush();
+
+			// Header
+			char* cursor = buffer.data + buffer.size;
+			uint16_t payload_size_16 = (uint16_t)payload_size;
+			uint8_t num_args_8 = (uint8_t)num_args;
+			memcpy(cursor, &site_id, 4);
+			memcpy(cursor + 4, &payload_size_16, 2);
+			memcpy(cursor + 6, &num_args_8, 1);
+			cursor += BINARY_LOG_RECORD_HEADER_SIZE;
+
+			// Arguments
+			for (uint32_t arg_idx = 0; arg_idx < num_args; ++arg_idx)
+			{
+				const Arg& arg = args[arg_idx];
+				*cursor++ = (char)arg.type;
+				if (arg.type == ArgType::string)
+				{
+					uint16_t length = (uint16_t)arg.bits;
+					memcpy(cursor, &length, 2);
+					memcpy(cursor + 2, arg.str, length);
+				}
+				else if (arg.size == 4)
+				{
+					uint32_t value = (uint32_t)arg.bits;
+					memcpy(cursor, &value, 4);
+				}
+				else
+				{
+					memcpy(cursor, &arg.bits, 8);
+				}
+				cursor += arg.size;
+			}
+			buffer.size += record_size;
+		}
+
+		void flush_thread()
+		{
+			__binary_log_buffer.flush();
+		}
+
+		uint64_t num_dropped()
+		{
+			return __binary_log_dropped.load(std::memory_order_relaxed);
+		}
+
+		void dump_dictionary(Vector<char>& output)
+		{
+			binary_log_registry().dump(output);
+		}
+
+		bool decode(const char* dictionary, uint32_t dictionary_size, const char* data, uint64_t data_size, DynamicString& output)
+		{
+			// Load the format sites
+			BinaryLogReader dictionary_reader = { dictionary, dictionary + dictionary_size };
+			uint32_t num_sites;
+			if (!dictionary_reader.read(num_sites) || num_sites > dictionary_size)
+			{
+				bento_log_error("LOG", "Corrupted binary log dictionary");
+				return false;
+			}
+			Vector<DecodedSite> sites(output._allocator, num_sites);
+			for (uint32_t site_idx = 0; site_idx < num_sites; ++site_idx)
+			{
+				DecodedSite& site = sites[site_idx];
+				if (!dictionary_reader.read(site.level) || !dictionary_reader.read(site.line)
+					|| !read_string(dictionary_reader, site.tag) || !read_string(dictionary_reader, site.format) || !read_string(dictionary_reader, site.file))
+				{
+					bento_log_error("LOG", "Corrupted binary log dictionary");
+					return false;
+				}
+			}
+
+			// Decode the records
+			BinaryLogReader reader = { data, data + data_size };
+			while (reader.cursor != reader.end)
+			{
+				uint32_t site_id;
+				uint16_t payload_size;
+				uint8_t num_args;
+				const char* payload;
+				if (!reader.read(site_id) || !reader.read(payload_size) || !reader.read(num_args) || !reader.read_view(payload_size, payload) || site_id >= num_sites)
+				{
+					bento_log_error("LOG", "Corrupted binary log record");
+					return false;
+				}
+
+				const DecodedSite& site = sites[site_id];
+				output += level_to_string((LogLevel::Type)site.level);
+				output += "[";
+				append_view(output, site.tag);
+				output += "]";
+				BinaryLogReader payload_reader = { payload, payload + payload_size };
+				if (!decode_message(payload_reader, num_args, site.format, output))
+				{
+					bento_log_error("LOG", "Corrupted binary log arguments");
+					return false;
+				}
+				output += "\n";
+			}
+			return true;
+		}
+	}
+}
@@ -0,0 +1,122 @@
+// Library includes
+#include "bento_base/checksum.h"
+
+// External includes
+#include <string.h>
+#if defined(__x86_64__) || defined(_M_X64)
+	#define BENTO_CRC32C_SSE42
+	#if defined(WINDOWSPC)
+		#include <intrin.h>
+		#include <nmmintrin.h>
+	#else
+		#include <cpuid.h>
+		#include <nmmintrin.h>
+	#endif
+#endif
+
+namespace bento {
+
+	// Reflected Castagnoli polynomial
+	const uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+	// Tables of the slicing-by-8 fallback, table[k][b] is the crc of byte b followed by k zero bytes
+	struct CRC32CTables
+	{
+		CRC32CTables()
+		{
+			for (uint32_t byte = 0; byte < 256; ++byte)
+			{
+				uint32_t crc = byte;
+				for (uint32_t bit = 0; bit < 8; ++bit)
+					crc = (crc >> 1) ^ (CRC32C_POLYNOMIAL & (0u - (crc & 1)));
+				table[0][byte] = crc;
+			}
+			for (uint32_t byte = 0; byte < 256; ++byte)
+			{
+				for (uint32_t slice = 1; slice < 8; ++slice)
+					table[slice][byte] = (table[slice - 1][byte] >> 8) ^ table[0][table[slice - 1][byte] & 0xFF];
+			}
+		}
+
+		uint32_t table[8][256];
+	};
+
+	static const CRC32CTables& crc32c_tables()
+	{
+		static CRC32CTables tables;
+		return tables;
+	}
+
+	static uint32_t crc32c_software(const unsigned char* data, uint64_t size, uint32_t crc)
+	{
+		const uint32_t (*table)[256] = crc32c_tables().table;
+		while (size >= 8)
+		{
+			uint32_t low, high;
+			memcpy(&low, data, sizeof(low));
+			memcpy(&high, data + 4, sizeof(high));
+			low ^= crc;
+			crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^ table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24]
+				^ table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF] ^ table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+			data += 8;
+			size -= 8;
+		}
+		while (size--)
+			crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+		return crc;
+	}
+
+#if defined(BENTO_CRC32C_SSE42)
+	#if !defined(WINDOWSPC)
+	__attribute__((target("sse4.2")))
+	#endif
+	static uint32_t crc32c_hardware(const unsigned char* data, uint64_t size, uint32_t crc)
+	{
+		// Align the reads, then 8 bytes per instruction
+		while (size > 0 && ((uintptr_t)data & 7) != 0)
+		{
+			crc = _mm_crc32_u8(crc, *data++);
+			--size;
+		}
+		uint64_t crc64 = crc;
+		while (size >= 8)
+		{
+			uint64_t word;
+			memcpy(&word, data, sizeof(word));
+			crc64 = _mm_crc32_u64(crc64, word);
+			data += 8;
+			size -= 8;
+		}
+		crc = (uint32_t)crc64;
+		while (size--)
+			crc = _mm_crc32_u8(crc, *data++);
+		return crc;
+	}
+
+	static bool cpu_supports_sse42()
+	{
+	#if defined(WINDOWSPC)
+		int registers[4];
+		__cpuid(registers, 1);
+		return (registers[2] & (1 << 20)) != 0;
+	#else
+		unsigned int eax, ebx, ecx, edx;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			return false;
+		return (ecx & bit_SSE4_2) != 0;
+	#endif
+	}
+#endif
+
+	uint32_t crc32c(const void* data, uint64_t size, uint32_t crc)
+	{
+		const unsigned char* bytes = (const unsigned char*)data;
+		crc = ~crc;
+	#if defined(BENTO_CRC32C_SSE42)
+		static const bool has_sse42 = cpu_supports_sse42();
+		if (has_sse42)
+			return ~crc32c_hardware(bytes, size, crc);
+	#endif
+		return ~crc32c_software(bytes, size, crc);
+	}
+}
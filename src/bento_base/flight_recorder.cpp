@@ -0,0 +1,295 @@
+// Library includes
+#include "bento_base/flight_recorder.h"
+#include "bento_base/security.h"
+#include "bento_base/system_logger.h"
+
+// External includes
+#include <signal.h>
+#include <fcntl.h>
+#if defined(WINDOWSPC)
+	#include <io.h>
+	#define flight_recorder_write _write
+	#define flight_recorder_open _open
+	#define flight_recorder_close _close
+#else
+	#include <unistd.h>
+	#define flight_recorder_write write
+	#define flight_recorder_open open
+	#define flight_recorder_close close
+#endif
+
+namespace bento {
+
+	// The recorder that is dumped on failures and signals
+	std::atomic<FlightRecorderLogger*> __installed_flight_recorder(nullptr);
+
+	// Signals that trigger a dump
+	const int FLIGHT_RECORDER_SIGNALS[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+	#if defined(SIGBUS)
+		SIGBUS,
+	#endif
+	};
+	const uint32_t FLIGHT_RECORDER_NUM_SIGNALS = sizeof(FLIGHT_RECORDER_SIGNALS) / sizeof(int);
+
+	// Handlers the application had before the recorder was installed, the signals are chained to them
+	#if defined(WINDOWSPC)
+	typedef void (*SignalHandler)(int);
+	SignalHandler __previous_signal_handlers[FLIGHT_RECORDER_NUM_SIGNALS];
+	#else
+	struct sigaction __previous_signal_actions[FLIGHT_RECORDER_NUM_SIGNALS];
+	#endif
+
+	// Set when a failure was dumped, the abort that follows it does not dump the same history again.
+	// Any record added after the failure clears it (the failure did not abort).
+	std::atomic<bool> __flight_recorder_failed(false);
+
+	static void flight_recorder_fail(const char* msg, const char* file_name, int)
+	{
+		FlightRecorderLogger* recorder = __installed_flight_recorder.load(std::memory_order_acquire);
+		if (recorder != nullptr)
+		{
+			// The failure closes the history
+			recorder->log(LogLevel::error, "FAILURE", msg);
+			recorder->log(LogLevel::error, "FAILURE", file_name);
+			recorder->dump();
+			__flight_recorder_failed.store(true, std::memory_order_release);
+		}
+	}
+
+	static uint32_t flight_recorder_signal_index(int signal_id)
+	{
+		for (uint32_t signal_idx = 0; signal_idx < FLIGHT_RECORDER_NUM_SIGNALS; ++signal_idx)
+		{
+			if (FLIGHT_RECORDER_SIGNALS[signal_idx] == signal_id)
+				return signal_idx;
+		}
+		return 0;
+	}
+
+	static void flight_recorder_dump_signal(int signal_id)
+	{
+		FlightRecorderLogger* recorder = __installed_flight_recorder.exchange(nullptr);
+		if (recorder != nullptr && !(signal_id == SIGABRT && __flight_recorder_failed.load(std::memory_order_acquire)))
+			recorder->dump();
+	}
+
+	#if defined(WINDOWSPC)
+	static void flight_recorder_signal(int signal_id)
+	{
+		flight_recorder_dump_signal(signal_id);
+
+		// Chain to the handler of the application, or let the default handler terminate the program
+		SignalHandler previous = __previous_signal_handlers[flight_recorder_signal_index(signal_id)];
+		if (previous != SIG_DFL && previous != SIG_IGN && previous != SIG_ERR)
+		{
+			previous(signal_id);
+			return;
+		}
+		signal(signal_id, SIG_DFL);
+		raise(signal_id);
+	}
+	#else
+	static void flight_recorder_signal(int signal_id, siginfo_t* info, void* context)
+	{
+		flight_recorder_dump_signal(signal_id);
+
+		// Chain to the handler of the application, or let the default handler terminate the program
+		const struct sigaction& previous = __previous_signal_actions[flight_recorder_signal_index(signal_id)];
+		if ((previous.sa_flags & SA_SIGINFO) != 0)
+		{
+			previous.sa_sigaction(signal_id, info, context);
+			return;
+		}
+		if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN)
+		{
+			previous.sa_handler(signal_id);
+			return;
+		}
+		signal(signal_id, SIG_DFL);
+		raise(signal_id);
+	}
+	#endif
+
+	// Only the async-signal-safe functions are used to write the dumps
+	static void write_all(int file_descriptor, const char* data, size_t size)
+	{
+		while (size > 0)
+		{
+			int written = (int)flight_recorder_write(file_descriptor, data, (unsigned int)size);
+			if (written <= 0)
+				return;
+			data += written;
+			size -= (size_t)written;
+		}
+	}
+
+	static void append_text(char* buffer, size_t& size, size_t capacity, const char* text)
+	{
+		while (*text != '\0' && size < capacity)
+			buffer[size++] = *text++;
+	}
+
+	FlightRecorderLogger::FlightRecorderLogger(IAllocator& allocator, uint32_t capacity, const char* dump_path)
+	: _allocator(allocator)
+	, _slots(nullptr)
+	, _capacity(capacity > 0 ? capacity : 1)
+	, _next(0)
+	, _installed(false)
+	, _handles_signals(false)
+	{
+		_slots = (Slot*)_allocator.allocate(sizeof(Slot) * _capacity, 64);
+		for (uint32_t slot_idx = 0; slot_idx < _capacity; ++slot_idx)
+			_slots[slot_idx].sequence.store(UINT64_MAX, std::memory_order_relaxed);
+		copy_truncated(_dump_path, dump_path, sizeof(_dump_path));
+	}
+
+	FlightRecorderLogger::~FlightRecorderLogger()
+	{
+		uninstall();
+		_allocator.deallocate(_slots);
+	}
+
+	FlightRecorderLogger::Slot& FlightRecorderLogger::acquire_slot(uint64_t& sequence)
+	{
+		// The slot is flagged while it is written so a concurrent dump skips it
+		sequence = _next.fetch_add(1, std::memory_order_relaxed);
+		Slot& slot = _slots[sequence % _capacity];
+		slot.sequence.store(UINT64_MAX, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		return slot;
+	}
+
+	void FlightRecorderLogger::log(LogLevel::Type log_level, const char* tag, const char* message)
+	{
+		if (__flight_recorder_failed.load(std::memory_order_relaxed))
+			__flight_recorder_failed.store(false, std::memory_order_relaxed);
+		uint64_t sequence;
+		Slot& slot = acquire_slot(sequence);
+		slot.record.level = log_level;
+		slot.record.new_line = false;
+		copy_truncated(slot.record.tag, tag, LOG_RECORD_TAG_SIZE);
+		copy_truncated(slot.record.message, message, LOG_RECORD_MESSAGE_SIZE);
+		slot.sequence.store(sequence, std::memory_order_release);
+	}
+
+	void FlightRecorderLogger::new_line()
+	{
+		if (__flight_recorder_failed.load(std::memory_order_relaxed))
+			__flight_recorder_failed.store(false, std::memory_order_relaxed);
+		uint64_t sequence;
+		Slot& slot = acquire_slot(sequence);
+		slot.record.level = LogLevel::info;
+		slot.record.new_line = true;
+		slot.sequence.store(sequence, std::memory_order_release);
+	}
+
+	void FlightRecorderLogger::install(bool handle_signals)
+	{
+		FlightRecorderLogger* previous = nullptr;
+		if (!__installed_flight_recorder.compare_exchange_strong(previous, this))
+		{
+			assert_fail_msg("A flight recorder is already installed");
+			return;
+		}
+		__flight_recorder_failed.store(false, std::memory_order_relaxed);
+		set_log_recorder(this);
+		set_fail_callback(flight_recorder_fail);
+		if (handle_signals)
+		{
+			for (uint32_t signal_idx = 0; signal_idx < FLIGHT_RECORDER_NUM_SIGNALS; ++signal_idx)
+			{
+			#if defined(WINDOWSPC)
+				__previous_signal_handlers[signal_idx] = signal(FLIGHT_RECORDER_SIGNALS[signal_idx], flight_recorder_signal);
+			#else
+				struct sigaction action;
+				memset(&action, 0, sizeof(action));
+				action.sa_sigaction = flight_recorder_signal;
+				action.sa_flags = SA_SIGINFO;
+				sigemptyset(&action.sa_mask);
+				sigaction(FLIGHT_RECORDER_SIGNALS[signal_idx], &action, &__previous_signal_actions[signal_idx]);
+			#endif
+			}
+		}
+		_handles_signals = handle_signals;
+		_installed = true;
+	}
+
+	void FlightRecorderLogger::uninstall()
+	{
+		if (!_installed)
+			return;
+		FlightRecorderLogger* installed = this;
+		__installed_flight_recorder.compare_exchange_strong(installed, nullptr);
+
+		// A signal may have taken the recorder out already, the hooks still have to be removed
+		if (log_recorder() == this)
+			set_log_recorder(nullptr);
+		if (fail_callback() == flight_recorder_fail && __installed_flight_recorder.load(std::memory_order_acquire) == nullptr)
+			set_fail_callback(nullptr);
+
+		// Give the signals back to the handlers of the application
+		if (_handles_signals)
+		{
+			for (uint32_t signal_idx = 0; signal_idx < FLIGHT_RECORDER_NUM_SIGNALS; ++signal_idx)
+			{
+			#if defined(WINDOWSPC)
+				signal(FLIGHT_RECORDER_SIGNALS[signal_idx], __previous_signal_handlers[signal_idx]);
+			#else
+				sigaction(FLIGHT_RECORDER_SIGNALS[signal_idx], &__previous_signal_actions[signal_idx], nullptr);
+			#endif
+			}
+		}
+		_handles_signals = false;
+		_installed = false;
+	}
+
+	void FlightRecorderLogger::dump(int file_descriptor) const
+	{
+		const char* header = "---- Flight recorder ----\n";
+		write_all(file_descriptor, header, strlen(header));
+
+		uint64_t last = _next.load(std::memory_order_acquire);
+		uint64_t first = last > _capacity ? last - _capacity : 0;
+		char line[LOG_RECORD_TAG_SIZE + LOG_RECORD_MESSAGE_SIZE + 16];
+		for (uint64_t sequence = first; sequence < last; ++sequence)
+		{
+			// Copy the record and make sure it was not overwritten in the meantime
+			const Slot& slot = _slots[sequence % _capacity];
+			if (slot.sequence.load(std::memory_order_acquire) != sequence)
+				continue;
+			LogRecord record = slot.record;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+				continue;
+
+			size_t size = 0;
+			if (!record.new_line)
+			{
+				record.tag[LOG_RECORD_TAG_SIZE - 1] = '\0';
+				record.message[LOG_RECORD_MESSAGE_SIZE - 1] = '\0';
+				append_text(line, size, sizeof(line) - 1, level_to_string(record.level));
+				append_text(line, size, sizeof(line) - 1, "[");
+				append_text(line, size, sizeof(line) - 1, record.tag);
+				append_text(line, size, sizeof(line) - 1, "]");
+				append_text(line, size, sizeof(line) - 1, record.message);
+			}
+			line[size++] = '\n';
+			write_all(file_descriptor, line, size);
+		}
+	}
+
+	void FlightRecorderLogger::dump() const
+	{
+		if (_dump_path[0] != '\0')
+		{
+			int file_descriptor = flight_recorder_open(_dump_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			if (file_descriptor >= 0)
+			{
+				dump(file_descriptor);
+				flight_recorder_close(file_descriptor);
+				return;
+			}
+		}
+		dump(2);
+	}
+}
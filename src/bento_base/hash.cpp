@@ -1,8 +1,29 @@
 // Library includes
 #include "bento_base/hash.h"
 
+// External includes
+#include <string.h>
+#if defined(WINDOWSPC)
+#include <intrin.h>
+#endif
+
 namespace bento {
 
+	// Unaligned safe reads
+	inline uint32_t read_32(const unsigned char* data)
+	{
+		uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	inline uint64_t read_64(const unsigned char* data)
+	{
+		uint64_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
 	// Implementation taken from https://sites.google.com/site/murmurhash/
 	uint32_t murmur_hash ( const void * key, uint32_t len, uint32_t seed )
 	{
@@ -22,7 +43,7 @@ namespace bento {
 
 		while(len >= 4)
 		{
-			unsigned int k = *(unsigned int *)data;
+			unsigned int k = read_32(data);
 
 			k *= m; 
 			k ^= k >> r; 
@@ -55,19 +76,43 @@ namespace bento {
 		return h;
 	}
 
-	uint64_t murmur_hash_64(const void * key, uint32_t len, uint32_t seed)
+	// Word transforms applied to the key before it is mixed
+	struct IdentityTransform
+	{
+		static inline uint64_t word(uint64_t value) { return value; }
+		static inline uint64_t byte(unsigned char value) { return value; }
+	};
+
+	struct LowerCaseTransform
+	{
+		// Lower cases the 8 ascii characters of a word at once, the high bit of each byte flags the upper case ones
+		static inline uint64_t word(uint64_t value)
+		{
+			const uint64_t high_bits = 0x8080808080808080ull;
+			uint64_t heptets = value & ~high_bits;
+			uint64_t above_z = heptets + 0x2525252525252525ull;
+			uint64_t from_a = heptets + 0x3F3F3F3F3F3F3F3Full;
+			uint64_t is_upper = (from_a ^ above_z) & ~value & high_bits;
+			return value | (is_upper >> 2);
+		}
+		static inline uint64_t byte(unsigned char value) { return (value >= 'A' && value <= 'Z') ? value + 32 : value; }
+	};
+
+	template<typename Transform>
+	uint64_t murmur_hash_64_transform(const void * key, uint32_t len, uint32_t seed)
 	{
 		const uint64_t m = 0xc6a4a7935bd1e995;
 		const int r = 47;
 
 		uint64_t h = seed ^ (len * m);
 
-		const uint64_t * data = (const uint64_t *)key;
-		const uint64_t * end = data + (len / 8);
+		const unsigned char * data = (const unsigned char *)key;
+		const unsigned char * end = data + (len & ~7u);
 
 		while (data != end)
 		{
-			uint64_t k = *data++;
+			uint64_t k = Transform::word(read_64(data));
+			data += 8;
 
 			k *= m;
 			k ^= k >> r;
@@ -77,17 +122,17 @@ namespace bento {
 			h *= m;
 		}
 
-		const unsigned char * data2 = (const unsigned char*)data;
+		const unsigned char * data2 = data;
 
 		switch (len & 7)
 		{
-		case 7: h ^= uint64_t(data2[6]) << 48;
-		case 6: h ^= uint64_t(data2[5]) << 40;
-		case 5: h ^= uint64_t(data2[4]) << 32;
-		case 4: h ^= uint64_t(data2[3]) << 24;
-		case 3: h ^= uint64_t(data2[2]) << 16;
-		case 2: h ^= uint64_t(data2[1]) << 8;
-		case 1: h ^= uint64_t(data2[0]);
+		case 7: h ^= Transform::byte(data2[6]) << 48;
+		case 6: h ^= Transform::byte(data2[5]) << 40;
+		case 5: h ^= Transform::byte(data2[4]) << 32;
+		case 4: h ^= Transform::byte(data2[3]) << 24;
+		case 3: h ^= Transform::byte(data2[2]) << 16;
+		case 2: h ^= Transform::byte(data2[1]) << 8;
+		case 1: h ^= Transform::byte(data2[0]);
 			h *= m;
 		};
 
@@ -97,4 +142,226 @@ namespace bento {
 
 		return h;
 	}
+
+	uint64_t murmur_hash_64(const void * key, uint32_t len, uint32_t seed)
+	{
+		return murmur_hash_64_transform<IdentityTransform>(key, len, seed);
+	}
+
+	uint64_t murmur_hash_64_lower_case(const void * key, uint32_t len, uint32_t seed)
+	{
+		return murmur_hash_64_transform<LowerCaseTransform>(key, len, seed);
+	}
+
+	// Full 64x64 -> 128 bit multiplication, the low half goes in a and the high half in b
+	inline void multiply_128(uint64_t& a, uint64_t& b)
+	{
+	#if defined(WINDOWSPC)
+		a = _umul128(a, b, &b);
+	#else
+		__uint128_t r = (__uint128_t)a * b;
+		a = (uint64_t)r;
+		b = (uint64_t)(r >> 64);
+	#endif
+	}
+
+	inline uint64_t multiply_mix(uint64_t a, uint64_t b)
+	{
+		multiply_128(a, b);
+		return a ^ b;
+	}
+
+	// Reads 1 to 3 bytes
+	inline uint64_t read_small(const unsigned char* data, uint64_t len)
+	{
+		return ((uint64_t)data[0] << 16) | ((uint64_t)data[len >> 1] << 8) | data[len - 1];
+	}
+
+	// Default secret of wyhash
+	const uint64_t wyhash_secret[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+	// Implementation of wyhash (https://github.com/wangyi-fudan/wyhash, public domain) split in steps that the streaming hasher shares
+	inline uint64_t wyhash_seed(uint64_t seed)
+	{
+		return seed ^ multiply_mix(seed ^ wyhash_secret[0], wyhash_secret[1]);
+	}
+
+	// Keys of up to 16 bytes are read with overlapping loads
+	inline void wyhash_short(const unsigned char* data, uint64_t len, uint64_t& a, uint64_t& b)
+	{
+		if (len >= 4)
+		{
+			a = ((uint64_t)read_32(data) << 32) | read_32(data + ((len >> 3) << 2));
+			b = ((uint64_t)read_32(data + len - 4) << 32) | read_32(data + len - 4 - ((len >> 3) << 2));
+		}
+		else if (len > 0)
+		{
+			a = read_small(data, len);
+			b = 0;
+		}
+		else
+		{
+			a = b = 0;
+		}
+	}
+
+	// Three independent lanes to hide the multiplication latency
+	inline void wyhash_block(const unsigned char* data, uint64_t& seed, uint64_t& see1, uint64_t& see2)
+	{
+		seed = multiply_mix(read_64(data) ^ wyhash_secret[1], read_64(data + 8) ^ seed);
+		see1 = multiply_mix(read_64(data + 16) ^ wyhash_secret[2], read_64(data + 24) ^ see1);
+		see2 = multiply_mix(read_64(data + 32) ^ wyhash_secret[3], read_64(data + 40) ^ see2);
+	}
+
+	// Last 1 to 48 bytes of a key longer than 16 bytes, the final reads may overlap the 15 bytes that precede data
+	inline void wyhash_tail(const unsigned char* data, uint64_t remaining, uint64_t seed, uint64_t& a, uint64_t& b)
+	{
+		while (remaining > 16)
+		{
+			seed = multiply_mix(read_64(data) ^ wyhash_secret[1], read_64(data + 8) ^ seed);
+			data += 16;
+			remaining -= 16;
+		}
+		a = read_64(data + remaining - 16);
+		b = read_64(data + remaining - 8) ^ seed;
+	}
+
+	inline uint64_t wyhash_final(uint64_t a, uint64_t b, uint64_t len, uint32_t secret_idx)
+	{
+		return multiply_mix(a ^ wyhash_secret[secret_idx] ^ len, b ^ wyhash_secret[secret_idx + 1]);
+	}
+
+	// Returns the two halves of the last product, the 64 and 128 bit versions fold them differently
+	inline void wyhash_state(const void * key, uint64_t len, uint64_t seed, uint64_t& a, uint64_t& b)
+	{
+		const unsigned char* data = (const unsigned char*)key;
+		seed = wyhash_seed(seed);
+		if (len <= 16)
+		{
+			wyhash_short(data, len, a, b);
+			b ^= seed;
+		}
+		else
+		{
+			uint64_t remaining = len;
+			if (remaining > 48)
+			{
+				uint64_t see1 = seed, see2 = seed;
+				do
+				{
+					wyhash_block(data, seed, see1, see2);
+					data += 48;
+					remaining -= 48;
+				} while (remaining > 48);
+				seed ^= see1 ^ see2;
+			}
+			wyhash_tail(data, remaining, seed, a, b);
+		}
+		a ^= wyhash_secret[1];
+		multiply_128(a, b);
+	}
+
+	uint64_t fast_hash_64(const void * key, uint64_t len, uint64_t seed)
+	{
+		uint64_t a, b;
+		wyhash_state(key, len, seed, a, b);
+		return wyhash_final(a, b, len, 0);
+	}
+
+	Hash128 fast_hash_128(const void * key, uint64_t len, uint64_t seed)
+	{
+		// The second half folds the same state with the other two secret words
+		uint64_t a, b;
+		wyhash_state(key, len, seed, a, b);
+		Hash128 hash;
+		hash.low = wyhash_final(a, b, len, 0);
+		hash.high = wyhash_final(a, b, len, 2);
+		return hash;
+	}
+
+	FastHasher::FastHasher(uint64_t seed)
+	{
+		init(seed);
+	}
+
+	void FastHasher::init(uint64_t seed)
+	{
+		_seed = wyhash_seed(seed);
+		_see1 = _seed;
+		_see2 = _seed;
+		_length = 0;
+		_pending = 0;
+	}
+
+	void FastHasher::update(const void* data, uint64_t size)
+	{
+		const unsigned char* input = (const unsigned char*)data;
+		_length += size;
+
+		// Complete the pending block, it can only be processed once we know more bytes follow it
+		if (_pending > 0)
+		{
+			uint32_t copy_size = (uint32_t)(size < FAST_HASH_BLOCK_SIZE - _pending ? size : FAST_HASH_BLOCK_SIZE - _pending);
+			memcpy(_buffer + FAST_HASH_HISTORY_SIZE + _pending, input, copy_size);
+			_pending += copy_size;
+			input += copy_size;
+			size -= copy_size;
+			if (size == 0)
+				return;
+
+			wyhash_block(_buffer + FAST_HASH_HISTORY_SIZE, _seed, _see1, _see2);
+			memcpy(_buffer, _buffer + FAST_HASH_BLOCK_SIZE, FAST_HASH_HISTORY_SIZE);
+			_pending = 0;
+		}
+
+		// Hash the blocks straight from the input, the last one is kept until the end is known
+		if (size > FAST_HASH_BLOCK_SIZE)
+		{
+			do
+			{
+				wyhash_block(input, _seed, _see1, _see2);
+				input += FAST_HASH_BLOCK_SIZE;
+				size -= FAST_HASH_BLOCK_SIZE;
+			} while (size > FAST_HASH_BLOCK_SIZE);
+			memcpy(_buffer, input - FAST_HASH_HISTORY_SIZE, FAST_HASH_HISTORY_SIZE);
+		}
+		memcpy(_buffer + FAST_HASH_HISTORY_SIZE, input, (size_t)size);
+		_pending = (uint32_t)size;
+	}
+
+	void FastHasher::state(uint64_t& a, uint64_t& b) const
+	{
+		const unsigned char* pending = _buffer + FAST_HASH_HISTORY_SIZE;
+		if (_length <= 16)
+		{
+			wyhash_short(pending, _length, a, b);
+			b ^= _seed;
+		}
+		else
+		{
+			uint64_t seed = _seed;
+			if (_length > FAST_HASH_BLOCK_SIZE)
+				seed ^= _see1 ^ _see2;
+			wyhash_tail(pending, _pending, seed, a, b);
+		}
+		a ^= wyhash_secret[1];
+		multiply_128(a, b);
+	}
+
+	uint64_t FastHasher::finalize() const
+	{
+		uint64_t a, b;
+		state(a, b);
+		return wyhash_final(a, b, _length, 0);
+	}
+
+	Hash128 FastHasher::finalize_128() const
+	{
+		uint64_t a, b;
+		state(a, b);
+		Hash128 hash;
+		hash.low = wyhash_final(a, b, _length, 0);
+		hash.high = wyhash_final(a, b, _length, 2);
+		return hash;
+	}
 }
\ No newline at end of file
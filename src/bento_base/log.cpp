@@ -1,12 +1,297 @@
 // Library includes
 #include "bento_base/log.h"
 #include "bento_base/system_logger.h"
+#include "bento_base/hash.h"
+#include "bento_collection/vector.h"
+#include "bento_collection/flat_map.h"
+#include "bento_memory/common.h"
+
+// External includes
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
 
 namespace bento {
 	// This the default logger we provide for the user
 	SystemLogger __default_system_logger;
 	ILogger* __default_logger = &__default_system_logger;
 
+	// Default rate limit of the tags, nothing is dropped unless a limit is set
+	const uint32_t DEFAULT_LOG_MESSAGES_PER_SECOND = 0;
+	const uint32_t DEFAULT_LOG_BURST = 1000;
+
+	// Tags longer than this share their bucket with the tags that have the same prefix
+	const uint32_t LOG_TAG_BUCKET_NAME_SIZE = 32;
+
+	// Number of suppressed summaries a call can emit, the other ones stay pending for the next call
+	const uint32_t LOG_SUPPRESSED_REPORTS_SIZE = 8;
+
+	// Token bucket of a tag
+	struct LogTagBucket
+	{
+		uint64_t tag_hash;
+		char tag[LOG_TAG_BUCKET_NAME_SIZE];
+		bool own_limit;
+		double messages_per_second;
+		double burst;
+		double tokens;
+		uint64_t last_refill;
+		uint64_t suppressed;
+	};
+
+	// Suppressed summaries collected under the filter lock and emitted once it is released
+	struct LogSuppressedReports
+	{
+		char tags[LOG_SUPPRESSED_REPORTS_SIZE][LOG_TAG_BUCKET_NAME_SIZE];
+		uint64_t suppressed[LOG_SUPPRESSED_REPORTS_SIZE];
+		uint32_t num_reports;
+	};
+
+	class LogFilter
+	{
+	public:
+		LogFilter(IAllocator& allocator)
+		: _buckets(allocator)
+		, _bucket_index(allocator)
+		, _messages_per_second(DEFAULT_LOG_MESSAGES_PER_SECOND)
+		, _burst(DEFAULT_LOG_BURST)
+		, _num_limited(0)
+		, _num_pending(0)
+		, _active(DEFAULT_LOG_MESSAGES_PER_SECOND != 0)
+		{
+		}
+
+		// Is there a limit or a pending summary, the messages skip the filter otherwise
+		bool active() const
+		{
+			return _active.load(std::memory_order_relaxed);
+		}
+
+		void set_rate_limit(const char* tag, uint32_t messages_per_second, uint32_t burst)
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			LogTagBucket& bucket = find_bucket(tag);
+			if (bucket.own_limit && bucket.messages_per_second != 0.0)
+				--_num_limited;
+			bucket.own_limit = true;
+			reset_bucket(bucket, messages_per_second, burst);
+			if (messages_per_second != 0)
+				++_num_limited;
+			update_active();
+		}
+
+		void set_default_rate_limit(uint32_t messages_per_second, uint32_t burst)
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			_messages_per_second = messages_per_second;
+			_burst = burst;
+			uint32_t num_buckets = _buckets.size();
+			for (uint32_t bucket_idx = 0; bucket_idx < num_buckets; ++bucket_idx)
+			{
+				if (!_buckets[bucket_idx].own_limit)
+					reset_bucket(_buckets[bucket_idx], messages_per_second, burst);
+			}
+			update_active();
+		}
+
+		// Consume a token of the tag, returns the number of messages to report as suppressed before this one (UINT64_MAX if it is suppressed).
+		// The summaries of the other tags that are due are collected in reports, they must be logged once this returns.
+		uint64_t acquire(const char* tag, LogSuppressedReports& reports)
+		{
+			reports.num_reports = 0;
+			std::lock_guard<std::mutex> lock(_lock);
+			uint64_t now = current_time();
+			if (_num_pending != 0)
+				report_due(now, reports);
+
+			LogTagBucket& bucket = find_bucket(tag);
+			uint64_t suppressed = 0;
+			if (bucket.messages_per_second == 0.0)
+			{
+				suppressed = take_suppressed(bucket);
+			}
+			else
+			{
+				// Refill the bucket with the time spent since the last message
+				refill(bucket, now);
+				if (bucket.tokens < 1.0)
+				{
+					if (bucket.suppressed++ == 0)
+						++_num_pending;
+					suppressed = UINT64_MAX;
+				}
+				else
+				{
+					bucket.tokens -= 1.0;
+					suppressed = take_suppressed(bucket);
+				}
+			}
+			update_active();
+			return suppressed;
+		}
+
+		void report_suppressed()
+		{
+			LogSuppressedReports reports;
+			do
+			{
+				reports.num_reports = 0;
+				{
+					std::lock_guard<std::mutex> lock(_lock);
+					uint32_t num_buckets = _buckets.size();
+					for (uint32_t bucket_idx = 0; bucket_idx < num_buckets && reports.num_reports < LOG_SUPPRESSED_REPORTS_SIZE; ++bucket_idx)
+					{
+						LogTagBucket& bucket = _buckets[bucket_idx];
+						if (bucket.suppressed != 0)
+							add_report(reports, bucket);
+					}
+					update_active();
+				}
+				log_reports(reports);
+			} while (reports.num_reports == LOG_SUPPRESSED_REPORTS_SIZE);
+		}
+
+		// Must not be called with the lock held, the logger is free to log in turn
+		static void log_suppressed(const char* tag, uint64_t suppressed)
+		{
+			char message[64];
+			snprintf(message, sizeof(message), "%llu messages suppressed", (unsigned long long)suppressed);
+			__default_logger->log(LogLevel::warning, tag, message);
+		}
+
+		static void log_reports(const LogSuppressedReports& reports)
+		{
+			for (uint32_t report_idx = 0; report_idx < reports.num_reports; ++report_idx)
+				log_suppressed(reports.tags[report_idx], reports.suppressed[report_idx]);
+		}
+
+	private:
+		static uint64_t current_time()
+		{
+			return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		void refill(LogTagBucket& bucket, uint64_t now)
+		{
+			bucket.tokens += (double)(now - bucket.last_refill) * 1e-9 * bucket.messages_per_second;
+			bucket.tokens = bucket.tokens < bucket.burst ? bucket.tokens : bucket.burst;
+			bucket.last_refill = now;
+		}
+
+		uint64_t take_suppressed(LogTagBucket& bucket)
+		{
+			uint64_t suppressed = bucket.suppressed;
+			if (suppressed != 0)
+				--_num_pending;
+			bucket.suppressed = 0;
+			return suppressed;
+		}
+
+		void add_report(LogSuppressedReports& reports, LogTagBucket& bucket)
+		{
+			memcpy(reports.tags[reports.num_reports], bucket.tag, LOG_TAG_BUCKET_NAME_SIZE);
+			reports.suppressed[reports.num_reports] = take_suppressed(bucket);
+			++reports.num_reports;
+		}
+
+		void update_active()
+		{
+			_active.store(_messages_per_second != 0 || _num_limited != 0 || _num_pending != 0, std::memory_order_relaxed);
+		}
+
+		// Collect the suppressed messages of the tags that refilled a token since, even if they stopped logging
+		void report_due(uint64_t now, LogSuppressedReports& reports)
+		{
+			uint32_t num_buckets = _buckets.size();
+			for (uint32_t bucket_idx = 0; bucket_idx < num_buckets && reports.num_reports < LOG_SUPPRESSED_REPORTS_SIZE; ++bucket_idx)
+			{
+				LogTagBucket& bucket = _buckets[bucket_idx];
+				if (bucket.suppressed == 0)
+					continue;
+				if (bucket.messages_per_second != 0.0)
+				{
+					refill(bucket, now);
+					if (bucket.tokens < 1.0)
+						continue;
+				}
+				add_report(reports, bucket);
+			}
+		}
+
+		void reset_bucket(LogTagBucket& bucket, uint32_t messages_per_second, uint32_t burst)
+		{
+			bucket.messages_per_second = messages_per_second;
+			bucket.burst = burst > 0 ? burst : 1;
+			bucket.tokens = bucket.burst;
+			bucket.last_refill = current_time();
+		}
+
+		LogTagBucket& find_bucket(const char* tag)
+		{
+			// The tags are compared on their truncated name
+			char tag_name[LOG_TAG_BUCKET_NAME_SIZE];
+			size_t length = strlen(tag);
+			length = length < LOG_TAG_BUCKET_NAME_SIZE - 1 ? length : LOG_TAG_BUCKET_NAME_SIZE - 1;
+			memcpy(tag_name, tag, length);
+			tag_name[length] = '\0';
+			uint64_t tag_hash = murmur_hash_64(tag_name, (uint32_t)length, 0);
+
+			const uint32_t* indexed_bucket = _bucket_index.find(tag_hash);
+			if (indexed_bucket != nullptr)
+			{
+				LogTagBucket& bucket = _buckets[*indexed_bucket];
+				if (strcmp(bucket.tag, tag_name) == 0)
+					return bucket;
+
+				// Hash collision, only the first tag is indexed
+				uint32_t num_buckets = _buckets.size();
+				for (uint32_t bucket_idx = 0; bucket_idx < num_buckets; ++bucket_idx)
+				{
+					LogTagBucket& other_bucket = _buckets[bucket_idx];
+					if (other_bucket.tag_hash == tag_hash && strcmp(other_bucket.tag, tag_name) == 0)
+						return other_bucket;
+				}
+			}
+			else
+			{
+				_bucket_index.insert(tag_hash, _buckets.size());
+			}
+
+			// First message of this tag
+			LogTagBucket& bucket = _buckets.extend();
+			bucket.tag_hash = tag_hash;
+			memcpy(bucket.tag, tag_name, length + 1);
+			bucket.own_limit = false;
+			bucket.suppressed = 0;
+			reset_bucket(bucket, _messages_per_second, _burst);
+			return bucket;
+		}
+
+	private:
+		Vector<LogTagBucket> _buckets;
+		// Index of the bucket of a tag hash
+		FlatMap<uint64_t, uint32_t> _bucket_index;
+		uint32_t _messages_per_second;
+		uint32_t _burst;
+		// Number of tags that have their own non zero limit
+		uint32_t _num_limited;
+		// Number of tags that have suppressed messages to report
+		uint32_t _num_pending;
+		std::atomic<bool> _active;
+		std::mutex _lock;
+	};
+
+	LogFilter& log_filter()
+	{
+		static LogFilter __log_filter(*common_allocator());
+		return __log_filter;
+	}
+
+	std::atomic<uint32_t> __min_log_level(BENTO_LOG_MIN_LEVEL);
+	std::atomic<ILogger*> __log_recorder(nullptr);
+
 	ILogger* default_logger()
 	{
 		return __default_logger;
@@ -21,4 +306,71 @@ namespace bento {
 	{
 		__default_logger = &__default_system_logger;
 	}
-}
\ No newline at end of file
+
+	void set_min_log_level(LogLevel::Type log_level)
+	{
+		// The compile-time floor can't be lowered
+		uint32_t level = (uint32_t)log_level > BENTO_LOG_MIN_LEVEL ? (uint32_t)log_level : BENTO_LOG_MIN_LEVEL;
+		__min_log_level.store(level, std::memory_order_relaxed);
+	}
+
+	LogLevel::Type min_log_level()
+	{
+		return (LogLevel::Type)__min_log_level.load(std::memory_order_relaxed);
+	}
+
+	bool log_enabled(LogLevel::Type log_level)
+	{
+		return (uint32_t)log_level >= __min_log_level.load(std::memory_order_relaxed) || __log_recorder.load(std::memory_order_relaxed) != nullptr;
+	}
+
+	void set_log_recorder(ILogger* recorder)
+	{
+		__log_recorder.store(recorder, std::memory_order_release);
+	}
+
+	ILogger* log_recorder()
+	{
+		return __log_recorder.load(std::memory_order_acquire);
+	}
+
+	void set_log_rate_limit(const char* tag, uint32_t messages_per_second, uint32_t burst)
+	{
+		log_filter().set_rate_limit(tag, messages_per_second, burst);
+	}
+
+	void set_default_log_rate_limit(uint32_t messages_per_second, uint32_t burst)
+	{
+		log_filter().set_default_rate_limit(messages_per_second, burst);
+	}
+
+	void log_message(LogLevel::Type log_level, const char* tag, const char* message)
+	{
+		ILogger* recorder = __log_recorder.load(std::memory_order_acquire);
+		if (recorder != nullptr)
+			recorder->log(log_level, tag, message);
+		if ((uint32_t)log_level < __min_log_level.load(std::memory_order_relaxed))
+			return;
+
+		LogFilter& filter = log_filter();
+		if (!filter.active())
+		{
+			__default_logger->log(log_level, tag, message);
+			return;
+		}
+
+		LogSuppressedReports reports;
+		uint64_t suppressed = filter.acquire(tag, reports);
+		LogFilter::log_reports(reports);
+		if (suppressed == UINT64_MAX)
+			return;
+		if (suppressed != 0)
+			LogFilter::log_suppressed(tag, suppressed);
+		__default_logger->log(log_level, tag, message);
+	}
+
+	void report_suppressed_logs()
+	{
+		log_filter().report_suppressed();
+	}
+}
@@ -17,10 +17,26 @@ namespace bento {
 		#endif
 	}
 
-	void __handle_fail(const char* msg, const char* file_name, int)
+	FailCallback __fail_callback = nullptr;
+
+	void set_fail_callback(FailCallback callback)
+	{
+		__fail_callback = callback;
+	}
+
+	FailCallback fail_callback()
+	{
+		return __fail_callback;
+	}
+
+	void __handle_fail(const char* msg, const char* file_name, int line)
 	{
+		// Failures bypass the level filters and the rate limits
 		default_logger()->log(LogLevel::error, "FAILURE", msg);
 		default_logger()->log(LogLevel::error, "FAILURE", file_name);
+		default_logger()->flush();
+		if (__fail_callback != nullptr)
+			__fail_callback(msg, file_name, line);
 		print_trace();
 		assert(false);
 	}
@@ -1,5 +1,6 @@
 // SDK includes
 #include "bento_base/stream.h"
+#include "bento_base/security.h"
 
 // External includes
 #include <string.h>
@@ -10,16 +11,430 @@ namespace bento
 	{
 		if (write_size) {
 			uint32_t old_size = buffer.size();
+			if (write_size > UINT32_MAX - old_size)
+			{
+				assert_fail_msg("The data does not fit in a 32 bit buffer");
+				return;
+			}
 			buffer.resize(old_size + write_size);
-			memcpy(buffer.begin() + old_size, data, write_size);
+			if (buffer.size() == old_size + write_size)
+				memcpy(buffer.begin() + old_size, data, write_size);
 		}
 	}
 
-	void unpack_buffer(const char*& stream, uint32_t read_size, char* data)
+	void pack_buffer(Vector64<char>& buffer, uint64_t write_size, const char* data)
+	{
+		if (write_size) {
+			uint64_t old_size = buffer.size();
+			if (write_size > UINT64_MAX - old_size)
+			{
+				assert_fail_msg("The data does not fit in the buffer");
+				return;
+			}
+			buffer.resize(old_size + write_size);
+			if (buffer.size() == old_size + write_size)
+				memcpy(buffer.begin() + old_size, data, (size_t)write_size);
+		}
+	}
+
+	void unpack_buffer(const char*& stream, uint64_t read_size, char* data)
 	{
 		if (read_size) {
-			memcpy(data, stream, read_size);
+			memcpy(data, stream, (size_t)read_size);
 			stream += read_size;
 		}
 	}
-}
\ No newline at end of file
+
+	uint64_t unpack_count(const char*& stream, uint64_t max_count)
+	{
+		uint32_t short_count;
+		unpack_bytes(stream, short_count);
+		if (short_count != UINT32_MAX)
+			return short_count;
+
+		// Escaped 64 bit count
+		uint64_t count;
+		unpack_bytes(stream, count);
+		if (count > max_count)
+		{
+			assert_fail_msg("The element count does not fit in the target container");
+			return 0;
+		}
+		return count;
+	}
+
+	uint32_t encode_varint(uint64_t value, char* output)
+	{
+		uint32_t size = 0;
+		while (value >= 0x80)
+		{
+			output[size++] = (char)(value | 0x80);
+			value >>= 7;
+		}
+		output[size++] = (char)value;
+		return size;
+	}
+
+	uint32_t bit_width(uint64_t max_value)
+	{
+		uint32_t num_bits = 0;
+		while (max_value != 0)
+		{
+			++num_bits;
+			max_value >>= 1;
+		}
+		return num_bits;
+	}
+
+	void encode_bits(const uint32_t* values, uint32_t num_values, uint32_t num_bits, char* output)
+	{
+		// The accumulator never holds more than 7 + 32 bits
+		uint64_t mask = ((uint64_t)1 << num_bits) - 1;
+		uint64_t accumulator = 0;
+		uint32_t num_accumulated = 0;
+		for (uint32_t value_idx = 0; value_idx < num_values; ++value_idx)
+		{
+			accumulator |= (values[value_idx] & mask) << num_accumulated;
+			num_accumulated += num_bits;
+			while (num_accumulated >= 8)
+			{
+				*output++ = (char)accumulator;
+				accumulator >>= 8;
+				num_accumulated -= 8;
+			}
+		}
+		if (num_accumulated > 0)
+			*output = (char)accumulator;
+	}
+
+	void decode_bits(const char* input, uint32_t num_values, uint32_t num_bits, uint32_t* values)
+	{
+		const uint8_t* bytes = (const uint8_t*)input;
+		uint64_t mask = ((uint64_t)1 << num_bits) - 1;
+		uint64_t accumulator = 0;
+		uint32_t num_accumulated = 0;
+		for (uint32_t value_idx = 0; value_idx < num_values; ++value_idx)
+		{
+			while (num_accumulated < num_bits)
+			{
+				accumulator |= (uint64_t)(*bytes++) << num_accumulated;
+				num_accumulated += 8;
+			}
+			values[value_idx] = (uint32_t)(accumulator & mask);
+			accumulator >>= num_bits;
+			num_accumulated -= num_bits;
+		}
+	}
+
+	void pack_varint(Vector<char>& buffer, uint64_t value)
+	{
+		StreamWriter(buffer).write_varint(value);
+	}
+
+	// The 64 bit buffers have no writer, the encodings are appended with pack_buffer
+	void pack_varint(Vector64<char>& buffer, uint64_t value)
+	{
+		char bytes[MAX_VARINT_SIZE];
+		pack_buffer(buffer, encode_varint(value, bytes), bytes);
+	}
+
+	uint64_t unpack_varint(const char*& stream)
+	{
+		StreamReader reader = StreamReader::unbounded(stream);
+		uint64_t value = reader.read_varint();
+		stream = reader.cursor();
+		return value;
+	}
+
+	void pack_signed_varint(Vector<char>& buffer, int64_t value)
+	{
+		StreamWriter(buffer).write_signed_varint(value);
+	}
+
+	void pack_signed_varint(Vector64<char>& buffer, int64_t value)
+	{
+		pack_varint(buffer, zigzag_encode(value));
+	}
+
+	int64_t unpack_signed_varint(const char*& stream)
+	{
+		return zigzag_decode(unpack_varint(stream));
+	}
+
+	void pack_sorted_indices(Vector<char>& buffer, const uint32_t* indices, uint32_t num_indices)
+	{
+		StreamWriter(buffer).write_sorted_indices(indices, num_indices);
+	}
+
+	void pack_sorted_indices(Vector64<char>& buffer, const uint32_t* indices, uint32_t num_indices)
+	{
+		pack_varint(buffer, num_indices);
+		uint32_t previous = 0;
+		for (uint32_t index_idx = 0; index_idx < num_indices; ++index_idx)
+		{
+			assert_msg(indices[index_idx] >= previous, "The indices must be sorted");
+			pack_varint(buffer, indices[index_idx] - previous);
+			previous = indices[index_idx];
+		}
+	}
+
+	void unpack_sorted_indices(const char*& stream, Vector<uint32_t>& indices)
+	{
+		StreamReader reader = StreamReader::unbounded(stream);
+		reader.read_sorted_indices(indices);
+		stream = reader.cursor();
+	}
+
+	void pack_bit_packed(Vector<char>& buffer, const uint32_t* values, uint32_t num_values)
+	{
+		StreamWriter(buffer).write_bit_packed(values, num_values);
+	}
+
+	void pack_bit_packed(Vector64<char>& buffer, const uint32_t* values, uint32_t num_values)
+	{
+		uint32_t max_value = 0;
+		for (uint32_t value_idx = 0; value_idx < num_values; ++value_idx)
+			max_value |= values[value_idx];
+		uint8_t num_bits = (uint8_t)bit_width(max_value);
+		pack_varint(buffer, num_values);
+		pack_bytes(buffer, num_bits);
+		uint64_t data_size = ((uint64_t)num_values * num_bits + 7) / 8;
+		if (data_size)
+		{
+			uint64_t old_size = buffer.size();
+			buffer.resize(old_size + data_size);
+			if (buffer.size() == old_size + data_size)
+				encode_bits(values, num_values, num_bits, buffer.begin() + old_size);
+		}
+	}
+
+	void unpack_bit_packed(const char*& stream, Vector<uint32_t>& values, uint32_t max_values)
+	{
+		StreamReader reader = StreamReader::unbounded(stream);
+		reader.read_bit_packed(values, max_values);
+		stream = reader.cursor();
+	}
+
+	StreamReader::StreamReader(const char* data, uint64_t size)
+	: _begin(data)
+	, _cursor(data)
+	, _end(data + size)
+	, _failed(false)
+	{
+	}
+
+	StreamReader::StreamReader(const char* begin, const char* end)
+	: _begin(begin)
+	, _cursor(begin)
+	, _end(end)
+	, _failed(false)
+	{
+	}
+
+	StreamReader StreamReader::unbounded(const char* data)
+	{
+		return StreamReader(data, (const char*)nullptr);
+	}
+
+	void StreamReader::fail()
+	{
+		// An unbounded reader has no end to move to, it stays where the data was rejected
+		_failed = true;
+		if (_end != nullptr)
+			_cursor = _end;
+	}
+
+	bool StreamReader::read(char* data, uint64_t size)
+	{
+		const char* source = read_view(size);
+		if (source == nullptr)
+		{
+			memset(data, 0, (size_t)size);
+			return false;
+		}
+		memcpy(data, source, (size_t)size);
+		return true;
+	}
+
+	const char* StreamReader::read_view(uint64_t size)
+	{
+		if (_failed || size > remaining())
+		{
+			fail();
+			return nullptr;
+		}
+		const char* view = _cursor;
+		_cursor += size;
+		return view;
+	}
+
+	bool StreamReader::skip(uint64_t size)
+	{
+		return read_view(size) != nullptr;
+	}
+
+	uint64_t StreamReader::read_count(uint64_t max_count)
+	{
+		uint32_t short_count;
+		if (!read_bytes(short_count))
+			return 0;
+		if (short_count != UINT32_MAX)
+			return short_count;
+
+		// Escaped 64 bit count, malformed data must not assert
+		uint64_t count;
+		if (!read_bytes(count) || count > max_count)
+		{
+			fail();
+			return 0;
+		}
+		return count;
+	}
+
+	uint64_t StreamReader::read_varint()
+	{
+		uint64_t value = 0;
+		for (uint32_t byte_idx = 0; byte_idx < MAX_VARINT_SIZE; ++byte_idx)
+		{
+			const char* byte = read_view(1);
+			if (byte == nullptr)
+				return 0;
+			value |= (uint64_t)(*byte & 0x7F) << (7 * byte_idx);
+			if ((*byte & 0x80) == 0)
+				return value;
+		}
+
+		// More bytes than any 64 bit value needs
+		fail();
+		return 0;
+	}
+
+	int64_t StreamReader::read_signed_varint()
+	{
+		return zigzag_decode(read_varint());
+	}
+
+	bool StreamReader::read_sorted_indices(Vector<uint32_t>& indices)
+	{
+		// Every delta takes at least a byte, the count is validated before anything is allocated.
+		// An unbounded reader has no remaining size, the count still has to fit in the vector.
+		uint64_t num_indices = read_varint();
+		if (num_indices > remaining() || num_indices > UINT32_MAX)
+			fail();
+		if (_failed)
+		{
+			indices.resize(0);
+			return false;
+		}
+
+		indices.resize((uint32_t)num_indices);
+		if (indices.size() != num_indices)
+		{
+			fail();
+			return false;
+		}
+		uint32_t index = 0;
+		for (uint32_t index_idx = 0; index_idx < (uint32_t)num_indices; ++index_idx)
+		{
+			// The delta is checked before it is added so the index can't wrap
+			uint64_t delta = read_varint();
+			if (delta > UINT32_MAX - index)
+			{
+				fail();
+				delta = 0;
+			}
+			index += (uint32_t)delta;
+			indices[index_idx] = index;
+		}
+		return !_failed;
+	}
+
+	bool StreamReader::read_bit_packed(Vector<uint32_t>& values, uint32_t max_values)
+	{
+		uint64_t num_values = read_varint();
+		uint8_t num_bits = 0;
+		read_bytes(num_bits);
+		// The values can take 0 bits each, only the caller can bound their count
+		uint64_t data_size = (num_values * num_bits + 7) / 8;
+		if (num_bits > 32 || num_values > max_values || data_size > remaining())
+			fail();
+		if (_failed)
+		{
+			values.resize(0);
+			return false;
+		}
+
+		values.resize((uint32_t)num_values);
+		if (num_values)
+			decode_bits(read_view(data_size), (uint32_t)num_values, num_bits, values.begin());
+		return true;
+	}
+
+	void StreamWriter::write_varint(uint64_t value)
+	{
+		char bytes[MAX_VARINT_SIZE];
+		write(bytes, encode_varint(value, bytes));
+	}
+
+	void StreamWriter::write_sorted_indices(const uint32_t* indices, uint32_t num_indices)
+	{
+		write_varint(num_indices);
+		uint32_t previous = 0;
+		for (uint32_t index_idx = 0; index_idx < num_indices; ++index_idx)
+		{
+			assert_msg(indices[index_idx] >= previous, "The indices must be sorted");
+			write_varint(indices[index_idx] - previous);
+			previous = indices[index_idx];
+		}
+	}
+
+	void StreamWriter::write_bit_packed(const uint32_t* values, uint32_t num_values)
+	{
+		// The OR of the values has the bit width of the largest one
+		uint32_t max_value = 0;
+		for (uint32_t value_idx = 0; value_idx < num_values; ++value_idx)
+			max_value |= values[value_idx];
+		uint8_t num_bits = (uint8_t)bit_width(max_value);
+		write_varint(num_values);
+		write_bytes(num_bits);
+		uint32_t data_size = (uint32_t)(((uint64_t)num_values * num_bits + 7) / 8);
+		if (data_size)
+			encode_bits(values, num_values, num_bits, write_view(data_size));
+	}
+
+	StreamWriter::StreamWriter(Vector<char>& buffer)
+	: _buffer(buffer)
+	{
+	}
+
+	void StreamWriter::reserve(uint32_t size)
+	{
+		// Vector::reserve adds to the capacity, at least double it so the appends stay amortized
+		uint32_t capacity = _buffer.capacity();
+		uint32_t required = _buffer.size() + size;
+		if (required > capacity)
+		{
+			uint32_t missing = required - capacity;
+			_buffer.reserve(missing > capacity ? missing : capacity);
+		}
+	}
+
+	void StreamWriter::write(const char* data, uint32_t size)
+	{
+		if (size)
+			memcpy(write_view(size), data, size);
+	}
+
+	void StreamWriter::write_count(uint64_t count)
+	{
+		if (count < UINT32_MAX)
+		{
+			write_bytes((uint32_t)count);
+		}
+		else
+		{
+			write_bytes(UINT32_MAX);
+			write_bytes(count);
+		}
+	}
+}
@@ -0,0 +1,172 @@
+// Library includes
+#include "bento_collection/bitset.h"
+#include "bento_base/security.h"
+
+// External includes
+#include <string.h>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define BENTO_BITSET_SSE2
+#endif
+
+namespace bento
+{
+	namespace bit_array
+	{
+		void and_words(uint64_t* target, const uint64_t* source, uint32_t num_words)
+		{
+			uint32_t word_idx = 0;
+		#if defined(BENTO_BITSET_SSE2)
+			for (; word_idx + 2 <= num_words; word_idx += 2)
+			{
+				__m128i a = _mm_loadu_si128((const __m128i*)(target + word_idx));
+				__m128i b = _mm_loadu_si128((const __m128i*)(source + word_idx));
+				_mm_storeu_si128((__m128i*)(target + word_idx), _mm_and_si128(a, b));
+			}
+		#endif
+			for (; word_idx < num_words; ++word_idx)
+				target[word_idx] &= source[word_idx];
+		}
+
+		void or_words(uint64_t* target, const uint64_t* source, uint32_t num_words)
+		{
+			uint32_t word_idx = 0;
+		#if defined(BENTO_BITSET_SSE2)
+			for (; word_idx + 2 <= num_words; word_idx += 2)
+			{
+				__m128i a = _mm_loadu_si128((const __m128i*)(target + word_idx));
+				__m128i b = _mm_loadu_si128((const __m128i*)(source + word_idx));
+				_mm_storeu_si128((__m128i*)(target + word_idx), _mm_or_si128(a, b));
+			}
+		#endif
+			for (; word_idx < num_words; ++word_idx)
+				target[word_idx] |= source[word_idx];
+		}
+
+		void and_not_words(uint64_t* target, const uint64_t* source, uint32_t num_words)
+		{
+			uint32_t word_idx = 0;
+		#if defined(BENTO_BITSET_SSE2)
+			for (; word_idx + 2 <= num_words; word_idx += 2)
+			{
+				// _mm_andnot_si128 negates its first operand
+				__m128i a = _mm_loadu_si128((const __m128i*)(target + word_idx));
+				__m128i b = _mm_loadu_si128((const __m128i*)(source + word_idx));
+				_mm_storeu_si128((__m128i*)(target + word_idx), _mm_andnot_si128(b, a));
+			}
+		#endif
+			for (; word_idx < num_words; ++word_idx)
+				target[word_idx] &= ~source[word_idx];
+		}
+
+		uint32_t count_bits(const uint64_t* words, uint32_t num_words)
+		{
+			uint32_t count = 0;
+			for (uint32_t word_idx = 0; word_idx < num_words; ++word_idx)
+				count += ::count_bits(words[word_idx]);
+			return count;
+		}
+
+		uint32_t find_next_set(const uint64_t* words, uint32_t num_words, uint32_t first_bit)
+		{
+			uint32_t word_idx = first_bit / 64;
+			if (word_idx >= num_words)
+				return UINT32_MAX;
+
+			// Mask the bits before first_bit in the first word
+			uint64_t word = words[word_idx] & (~(uint64_t)0 << (first_bit % 64));
+			while (word == 0)
+			{
+				if (++word_idx == num_words)
+					return UINT32_MAX;
+				word = words[word_idx];
+			}
+			return word_idx * 64 + first_bit_set(word);
+		}
+	}
+
+	BitVector::BitVector(IAllocator& allocator)
+	: _words(allocator)
+	, _num_bits(0)
+	{
+	}
+
+	BitVector::BitVector(IAllocator& allocator, uint32_t num_bits)
+	: _words(allocator)
+	, _num_bits(0)
+	{
+		resize(num_bits);
+	}
+
+	void BitVector::resize(uint32_t num_bits)
+	{
+		uint32_t prev_num_words = _words.size();
+		uint32_t num_words = (num_bits + 63) / 64;
+		_words.resize(num_words);
+
+		// Clear the new words and the unused bits of the last one
+		if (num_words > prev_num_words)
+			memset(_words.begin() + prev_num_words, 0, (num_words - prev_num_words) * sizeof(uint64_t));
+		if (num_bits < _num_bits && (num_bits % 64))
+			_words[num_words - 1] &= ((uint64_t)1 << (num_bits % 64)) - 1;
+		_num_bits = num_bits;
+	}
+
+	void BitVector::set_all()
+	{
+		uint32_t num_words = _words.size();
+		if (num_words == 0)
+			return;
+
+		// The bits past the size stay cleared
+		memset(_words.begin(), 0xFF, num_words * sizeof(uint64_t));
+		if (_num_bits % 64)
+			_words[num_words - 1] = ((uint64_t)1 << (_num_bits % 64)) - 1;
+	}
+
+	void BitVector::clear_all()
+	{
+		memset(_words.begin(), 0, _words.size() * sizeof(uint64_t));
+	}
+
+	uint32_t BitVector::count() const
+	{
+		return bit_array::count_bits(_words.begin(), _words.size());
+	}
+
+	bool BitVector::any() const
+	{
+		return find_first_set() != UINT32_MAX;
+	}
+
+	uint32_t BitVector::find_first_set() const
+	{
+		return bit_array::find_next_set(_words.begin(), _words.size(), 0);
+	}
+
+	uint32_t BitVector::find_next_set(uint32_t first_bit) const
+	{
+		return bit_array::find_next_set(_words.begin(), _words.size(), first_bit);
+	}
+
+	BitVector& BitVector::operator&=(const BitVector& bit_vector)
+	{
+		assert_msg(_num_bits == bit_vector._num_bits, "Bit vectors must have the same size");
+		bit_array::and_words(_words.begin(), bit_vector._words.begin(), _words.size());
+		return *this;
+	}
+
+	BitVector& BitVector::operator|=(const BitVector& bit_vector)
+	{
+		assert_msg(_num_bits == bit_vector._num_bits, "Bit vectors must have the same size");
+		bit_array::or_words(_words.begin(), bit_vector._words.begin(), _words.size());
+		return *this;
+	}
+
+	BitVector& BitVector::and_not(const BitVector& bit_vector)
+	{
+		assert_msg(_num_bits == bit_vector._num_bits, "Bit vectors must have the same size");
+		bit_array::and_not_words(_words.begin(), bit_vector._words.begin(), _words.size());
+		return *this;
+	}
+}
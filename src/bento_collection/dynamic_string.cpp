@@ -1,9 +1,15 @@
 // Library includes
 #include "bento_collection/dynamic_string.h"
+#include "bento_base/hash.h"
+#include "bento_base/security.h"
 #include "bento_base/stream.h"
 
 // External includes
 #include <string.h>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define BENTO_STRING_SSE2
+#endif
 
 namespace bento
 {
@@ -37,6 +43,18 @@ namespace bento
 		}
 	}
 
+	DynamicString::DynamicString(IAllocator& allocator, const StringView& str)
+	: _allocator(allocator)
+	, _data(allocator)
+	{
+		uint32_t str_size = str.size();
+		resize(str_size);
+		if (str_size)
+		{
+			memcpy(_data.begin(), str.data(), str_size);
+		}
+	}
+
 	DynamicString::DynamicString(const DynamicString& str)
 	: _allocator(str._allocator)
 	, _data(str._allocator)
@@ -95,6 +113,19 @@ namespace bento
 		return *this;
 	}
 
+	DynamicString& DynamicString::operator=(const StringView& str)
+	{
+		// Set them to be the same size
+		uint32_t str_size = str.size();
+		resize(str_size);
+
+		// memcpy the buffer
+		if (str_size)
+			memcpy(_data.begin(), str.data(), str_size);
+
+		return *this;
+	}
+
 	DynamicString& DynamicString::operator+=(const char* str)
 	{
 		uint32_t current_size = size();
@@ -121,6 +152,26 @@ namespace bento
 		return !((*this) == str);
 	}
 
+	bool DynamicString::operator==(const StringView& str) const
+	{
+		return view() == str;
+	}
+
+	bool DynamicString::operator!=(const StringView& str) const
+	{
+		return !((*this) == str);
+	}
+
+	bool DynamicString::operator==(const DynamicString& str) const
+	{
+		return view() == str.view();
+	}
+
+	bool DynamicString::operator!=(const DynamicString& str) const
+	{
+		return !((*this) == str);
+	}
+
 	void DynamicString::append(const char* str, uint32_t sizeP)
 	{
 		uint32_t prevSize = size();
@@ -147,14 +198,91 @@ namespace bento
 			return char_idx != UINT32_MAX ? char_idx : path_size;
 		}
 
+		uint32_t find_last_of(const StringView& str, const char s)
+		{
+			uint32_t str_size = str.size();
+			uint32_t char_idx = str_size;
+			while (char_idx > 0)
+			{
+				--char_idx;
+				if (str[char_idx] == s)
+					return char_idx;
+			}
+			return str_size;
+		}
+
+	#if defined(BENTO_STRING_SSE2)
+		// Lower case 16 ascii characters at once (bytes above 127 are negative and never in range)
+		inline __m128i lower_case_block(__m128i block)
+		{
+			const __m128i is_upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+			return _mm_or_si128(block, _mm_and_si128(is_upper, _mm_set1_epi8(0x20)));
+		}
+	#endif
+
+		inline char lower_case_char(char character)
+		{
+			return (character >= 'A' && character <= 'Z') ? character + 32 : character;
+		}
+
+		void to_lower_case(char* str, uint32_t str_size)
+		{
+			uint32_t char_idx = 0;
+		#if defined(BENTO_STRING_SSE2)
+			for (; char_idx + 16 <= str_size; char_idx += 16)
+			{
+				__m128i block = _mm_loadu_si128((const __m128i*)(str + char_idx));
+				_mm_storeu_si128((__m128i*)(str + char_idx), lower_case_block(block));
+			}
+		#endif
+			for (; char_idx < str_size; ++char_idx)
+			{
+				str[char_idx] = lower_case_char(str[char_idx]);
+			}
+		}
+
 		void to_lower_case(DynamicString& target_string)
 		{
-			uint32_t num_chars = target_string.size();
-			char* character_array = target_string.c_str();
-			for(uint32_t char_idx = 0; char_idx < num_chars; ++char_idx)
+			to_lower_case(target_string.c_str(), target_string.size());
+		}
+
+		bool equals_ignore_case(const StringView& str0, const StringView& str1)
+		{
+			uint32_t str_size = str0.size();
+			if (str_size != str1.size())
+				return false;
+
+			const char* data0 = str0.data();
+			const char* data1 = str1.data();
+			uint32_t char_idx = 0;
+		#if defined(BENTO_STRING_SSE2)
+			for (; char_idx + 16 <= str_size; char_idx += 16)
 			{
-				character_array[char_idx] = (char)tolower(character_array[char_idx]);
+				__m128i block0 = lower_case_block(_mm_loadu_si128((const __m128i*)(data0 + char_idx)));
+				__m128i block1 = lower_case_block(_mm_loadu_si128((const __m128i*)(data1 + char_idx)));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(block0, block1)) != 0xFFFF)
+					return false;
 			}
+		#endif
+			for (; char_idx < str_size; ++char_idx)
+			{
+				if (lower_case_char(data0[char_idx]) != lower_case_char(data1[char_idx]))
+					return false;
+			}
+			return true;
+		}
+
+		uint64_t hash_ignore_case(const StringView& str)
+		{
+			return murmur_hash_64_lower_case(str.data(), str.size(), 0);
+		}
+
+		StringKey make_key(const StringView& str)
+		{
+			StringKey key;
+			key.str = str;
+			key.hash = murmur_hash_64(str.data(), str.size(), 0);
+			return key;
 		}
 
 		DynamicString substr(const DynamicString& source_string, uint32_t first_idx, uint32_t size)
@@ -164,75 +292,100 @@ namespace bento
 			return result_string;
 		}
 
-		void find_all_occurences(const char* source_str, uint32_t source_str_size, const char* to_find, uint32_t to_find_size, Vector<uint32_t>& results)
+		StringView substr(const StringView& source_string, uint32_t first_idx, uint32_t size)
 		{
-			uint32_t charIdx = 0;
-			while (charIdx < source_str_size)
+			return StringView(source_string.data() + first_idx, size);
+		}
+
+		uint32_t find(const char* source_str, uint32_t source_str_size, const char* to_find, uint32_t to_find_size, uint32_t start_idx)
+		{
+			// If there is not enough characters so that we can find the target string, we are done
+			if (to_find_size == 0 || start_idx > source_str_size || source_str_size - start_idx < to_find_size)
+				return UINT32_MAX;
+
+			// Single characters are a plain character search
+			if (to_find_size == 1)
 			{
-				// If there is not enough characters so that we can find the target string, we are done
-				if ((source_str_size - charIdx) < to_find_size)
-					break;
+				const char* occurence = (const char*)memchr(source_str + start_idx, to_find[0], source_str_size - start_idx);
+				return occurence != nullptr ? (uint32_t)(occurence - source_str) : UINT32_MAX;
+			}
 
-				bool found = false;
-				for (uint32_t toFindCharIdx = 0; toFindCharIdx < to_find_size; ++toFindCharIdx)
+			// Last index where an occurence may start
+			uint32_t last_candidate = source_str_size - to_find_size;
+			uint32_t char_idx = start_idx;
+
+		#if defined(BENTO_STRING_SSE2)
+			// Compare 16 candidates at once against the first and last characters of the target string, only the
+			// candidates that match both are fully compared
+			const __m128i first_char = _mm_set1_epi8(to_find[0]);
+			const __m128i last_char = _mm_set1_epi8(to_find[to_find_size - 1]);
+			for (; char_idx + 15 <= last_candidate; char_idx += 16)
+			{
+				const __m128i block_first = _mm_loadu_si128((const __m128i*)(source_str + char_idx));
+				const __m128i block_last = _mm_loadu_si128((const __m128i*)(source_str + char_idx + to_find_size - 1));
+				const __m128i matches = _mm_and_si128(_mm_cmpeq_epi8(first_char, block_first), _mm_cmpeq_epi8(last_char, block_last));
+				uint32_t mask = (uint32_t)_mm_movemask_epi8(matches);
+				while (mask != 0)
 				{
-					// If any char of the substr is not fullfilled, we are done
-					if (source_str[charIdx + toFindCharIdx] != to_find[toFindCharIdx])
-						break;
-
-					// We were able to find an occurence
-					if (toFindCharIdx == (to_find_size - 1))
-					{
-						results.push_back(charIdx);
-						found = true;
-					}
+					uint32_t candidate = char_idx + first_bit_set(mask);
+					if (memcmp(source_str + candidate + 1, to_find + 1, to_find_size - 2) == 0)
+						return candidate;
+					mask &= mask - 1;
 				}
+			}
+		#endif
 
-				charIdx += found ? to_find_size : 1;
+			// Process the remaining candidates one by one
+			for (; char_idx <= last_candidate; ++char_idx)
+			{
+				if (source_str[char_idx] == to_find[0] && memcmp(source_str + char_idx + 1, to_find + 1, to_find_size - 1) == 0)
+					return char_idx;
+			}
+			return UINT32_MAX;
+		}
+
+		void find_all_occurences(const char* source_str, uint32_t source_str_size, const char* to_find, uint32_t to_find_size, Vector<uint32_t>& results)
+		{
+			// Occurences do not overlap, the search resumes after each one of them
+			uint32_t occurence = find(source_str, source_str_size, to_find, to_find_size, 0);
+			while (occurence != UINT32_MAX)
+			{
+				results.push_back(occurence);
+				occurence = find(source_str, source_str_size, to_find, to_find_size, occurence + to_find_size);
 			}
 		}
 
 		void replace_substring(const DynamicString& source_string, const char* to_replace, const char* replacement, DynamicString& output_string)
 		{
-			// First we need to count the number of occurences of "to_replace" to know what is the the new length of the string
+			assert_msg(&source_string != &output_string, "The output string cannot be the source string");
 			uint32_t sourceLength = strlen32(to_replace);
 			if (sourceLength == 0)
 				return;
 
-			// Find all the occurences of the target to_replace string
+			// If no occurences we found we have nothing to do
+			const char* sourceData = source_string.c_str();
 			uint32_t stringSize = source_string.size();
-			Vector<uint32_t> occurences(*common_allocator());
-			find_all_occurences(source_string.c_str(), stringSize, to_replace, sourceLength, occurences);
-
-			// If no occurences we found we have nothingto do
-			uint32_t numOccurences = occurences.size();
-			if (numOccurences == 0)
+			uint32_t occurence = find(sourceData, stringSize, to_replace, sourceLength, 0);
+			if (occurence == UINT32_MAX)
 				return;
 
-			// Define the new size of the string
-			uint32_t targetLength = strlen32(replacement);
-			uint32_t newStringSize = stringSize - sourceLength * numOccurences + targetLength * numOccurences;
-			output_string.resize(newStringSize);
+			// Reserve the size of the source (enough when the replacement is not longer than the replaced string)
+			output_string.resize(stringSize);
+			output_string.resize(0);
 
-			// Actually replace the data
+			// Copy what is between the occurences and the replacement in a single pass
+			uint32_t targetLength = strlen32(replacement);
 			uint32_t inputCharIdx = 0;
-			uint32_t outputCharIdx = 0;
-			for (uint32_t occIdx = 0; occIdx < numOccurences; ++occIdx)
+			while (occurence != UINT32_MAX)
 			{
-				// First we need to copy what is before the occurence
-				uint32_t occurenceLocation = occurences[occIdx];
-				uint32_t sizeSinceLastOccurence = occurenceLocation - inputCharIdx;
-				memcpy(output_string.c_str() + outputCharIdx, source_string.c_str() + inputCharIdx, sizeSinceLastOccurence);
-				memcpy(output_string.c_str() + outputCharIdx + sizeSinceLastOccurence, replacement, targetLength);
-				inputCharIdx = occurenceLocation + sourceLength;
-				outputCharIdx += sizeSinceLastOccurence + targetLength;
+				output_string.append(sourceData + inputCharIdx, occurence - inputCharIdx);
+				output_string.append(replacement, targetLength);
+				inputCharIdx = occurence + sourceLength;
+				occurence = find(sourceData, stringSize, to_replace, sourceLength, inputCharIdx);
 			}
 
-			if (inputCharIdx < stringSize - 1)
-			{
-				uint32_t remainingSize = stringSize - inputCharIdx;
-				memcpy(output_string.c_str() + outputCharIdx, source_string.c_str() + inputCharIdx, remainingSize);
-			}
+			// Copy what is after the last occurence
+			output_string.append(sourceData + inputCharIdx, stringSize - inputCharIdx);
 		}
 	}
 
@@ -241,6 +394,11 @@ namespace bento
 		pack_vector_bytes(buffer, str._data);
 	}
 
+	void pack_type(Vector64<char>& buffer, const DynamicString& str)
+	{
+		pack_vector_bytes(buffer, str._data);
+	}
+
 	void unpack_type(const char*& stream, DynamicString& str)
 	{
 		unpack_vector_bytes(stream, str._data);
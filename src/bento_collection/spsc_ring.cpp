@@ -0,0 +1,96 @@
+// Library includes
+#include "bento_collection/spsc_ring.h"
+
+namespace bento {
+
+	// Header value that tells the consumer to skip to the beginning of the ring
+	const uint32_t FRAME_WRAP_MARKER = UINT32_MAX;
+
+	// Frames are stored with a 4 bytes size header and padded to keep the headers aligned (computed on 64 bits so huge sizes can be rejected)
+	inline uint64_t frame_footprint(uint32_t size)
+	{
+		return (sizeof(uint32_t) + (uint64_t)size + 3) & ~(uint64_t)3;
+	}
+
+	SPSCFrameRing::SPSCFrameRing(IAllocator& allocator, uint32_t capacity)
+	: _ring(allocator, capacity < 8 ? 8 : capacity)
+	, _pending_write(0)
+	, _pending_read(0)
+	{
+	}
+
+	char* SPSCFrameRing::reserve_frame(uint32_t size)
+	{
+		// A frame larger than half the ring may never fit next to the part skipped at its end
+		uint64_t frame_size = frame_footprint(size);
+		if (frame_size > _ring.capacity() / 2)
+			return nullptr;
+		uint32_t footprint = (uint32_t)frame_size;
+
+		Span<char> span = _ring.reserve_write(footprint);
+		if (span.size < footprint)
+		{
+			// Refresh the free space, the frame may not fit before the end of the ring
+			uint32_t free_space = _ring.available_write();
+			span = _ring.reserve_write(footprint);
+			if (span.size < footprint)
+			{
+				// Not enough space to skip the end of the ring and write the frame at the beginning
+				if (free_space < span.size + footprint)
+					return nullptr;
+				memcpy(span.data, &FRAME_WRAP_MARKER, sizeof(uint32_t));
+				_ring.commit_write(span.size);
+				span = _ring.reserve_write(footprint);
+			}
+		}
+
+		// Write the header, the payload is written in place by the caller
+		memcpy(span.data, &size, sizeof(uint32_t));
+		_pending_write = footprint;
+		return span.data + sizeof(uint32_t);
+	}
+
+	void SPSCFrameRing::commit_frame()
+	{
+		_ring.commit_write(_pending_write);
+		_pending_write = 0;
+	}
+
+	bool SPSCFrameRing::write_frame(const void* data, uint32_t size)
+	{
+		char* frame = reserve_frame(size);
+		if (frame == nullptr)
+			return false;
+		memcpy(frame, data, size);
+		commit_frame();
+		return true;
+	}
+
+	const char* SPSCFrameRing::read_frame(uint32_t& size)
+	{
+		Span<const char> span = _ring.reserve_read();
+		if (span.size == 0)
+			return nullptr;
+
+		// Skip the end of the ring if the producer wrapped
+		memcpy(&size, span.data, sizeof(uint32_t));
+		if (size == FRAME_WRAP_MARKER)
+		{
+			_ring.commit_read(span.size);
+			span = _ring.reserve_read();
+			if (span.size == 0)
+				return nullptr;
+			memcpy(&size, span.data, sizeof(uint32_t));
+		}
+
+		// Frames are always committed whole
+		_pending_read = (uint32_t)frame_footprint(size);
+		return span.data + sizeof(uint32_t);
+	}
+
+	void SPSCFrameRing::release_frame()
+	{
+		_ring.commit_read(_pending_read);
+		_pending_read = 0;
+	}
+}
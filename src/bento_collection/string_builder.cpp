@@ -0,0 +1,266 @@
+// Library includes
+#include "bento_collection/string_builder.h"
+#include "bento_base/security.h"
+
+// External includes
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#if defined(WINDOWSPC)
+#include <io.h>
+#endif
+
+namespace bento {
+
+	// Default size of the first block of a builder
+	const uint32_t STRING_BUILDER_BLOCK_SIZE = 4096;
+
+	// The block size doubles with every new block until this limit
+	const uint32_t STRING_BUILDER_MAX_BLOCK_SIZE = 1024 * 1024;
+
+	// Largest number of decimals append_float writes
+	const uint32_t STRING_BUILDER_MAX_PRECISION = 100;
+
+	struct StringBuilderBlock
+	{
+		StringBuilderBlock* next;
+		uint32_t capacity;
+		uint32_t used;
+	};
+
+	inline char* block_characters(StringBuilderBlock* block)
+	{
+		return (char*)(block + 1);
+	}
+
+	inline int64_t write_to_descriptor(int file_descriptor, const char* data, uint32_t size)
+	{
+		#if defined(WINDOWSPC)
+		return _write(file_descriptor, data, size);
+		#else
+		return write(file_descriptor, data, size);
+		#endif
+	}
+
+	StringBuilder::StringBuilder(IAllocator& allocator)
+	: _first(nullptr)
+	, _last(nullptr)
+	, _block_size(STRING_BUILDER_BLOCK_SIZE)
+	, _size(0)
+	, _allocator(allocator)
+	{
+	}
+
+	StringBuilder::StringBuilder(IAllocator& allocator, uint32_t block_size)
+	: _first(nullptr)
+	, _last(nullptr)
+	, _block_size(block_size)
+	, _size(0)
+	, _allocator(allocator)
+	{
+	}
+
+	StringBuilder::~StringBuilder()
+	{
+		StringBuilderBlock* block = _first;
+		while (block != nullptr)
+		{
+			StringBuilderBlock* next = block->next;
+			_allocator.deallocate(block);
+			block = next;
+		}
+	}
+
+	void StringBuilder::append_block(uint32_t min_capacity)
+	{
+		uint32_t capacity = min_capacity > _block_size ? min_capacity : _block_size;
+		StringBuilderBlock* block = (StringBuilderBlock*)_allocator.allocate(sizeof(StringBuilderBlock) + capacity, 8);
+		block->next = nullptr;
+		block->capacity = capacity;
+		block->used = 0;
+
+		// Link it at the end of the chain
+		if (_last != nullptr)
+			_last->next = block;
+		else
+			_first = block;
+		_last = block;
+
+		// The next block will be bigger
+		if (_block_size < STRING_BUILDER_MAX_BLOCK_SIZE)
+			_block_size *= 2;
+	}
+
+	char* StringBuilder::reserve_characters(uint32_t num_chars)
+	{
+		if (_last == nullptr || _last->capacity - _last->used < num_chars)
+			append_block(num_chars);
+		char* data = block_characters(_last) + _last->used;
+		_last->used += num_chars;
+		_size += num_chars;
+		return data;
+	}
+
+	void StringBuilder::append(const char* str, uint32_t str_size)
+	{
+		// Fill what is left of the current block first
+		if (_last != nullptr)
+		{
+			uint32_t available = _last->capacity - _last->used;
+			uint32_t copy_size = available < str_size ? available : str_size;
+			memcpy(block_characters(_last) + _last->used, str, copy_size);
+			_last->used += copy_size;
+			_size += copy_size;
+			str += copy_size;
+			str_size -= copy_size;
+		}
+
+		// The rest goes in a new block
+		if (str_size)
+			memcpy(reserve_characters(str_size), str, str_size);
+	}
+
+	void StringBuilder::append(const StringView& str)
+	{
+		append(str.data(), str.size());
+	}
+
+	void StringBuilder::append(char character)
+	{
+		*reserve_characters(1) = character;
+	}
+
+	void StringBuilder::append_uint(uint64_t value)
+	{
+		// Write the digits backward
+		char digits[20];
+		uint32_t num_digits = 0;
+		do
+		{
+			digits[19 - num_digits] = (char)('0' + value % 10);
+			value /= 10;
+			num_digits++;
+		} while (value != 0);
+		append(digits + 20 - num_digits, num_digits);
+	}
+
+	void StringBuilder::append_int(int64_t value)
+	{
+		if (value < 0)
+		{
+			append('-');
+			append_uint(~(uint64_t)value + 1);
+		}
+		else
+		{
+			append_uint((uint64_t)value);
+		}
+	}
+
+	void StringBuilder::append_float(double value, uint32_t precision)
+	{
+		// Non finite and huge values are not worth a custom path, the output stays fixed-point like the fast path
+		double magnitude = fabs(value);
+		if (!(magnitude < 1e18) || precision > 9)
+		{
+			// Room for the 309 integer digits of the largest double and the clamped precision
+			char buffer[512];
+			precision = precision < STRING_BUILDER_MAX_PRECISION ? precision : STRING_BUILDER_MAX_PRECISION;
+			int num_chars = snprintf(buffer, sizeof(buffer), "%.*f", (int)precision, value);
+			if (num_chars > 0)
+				append(buffer, (uint32_t)num_chars < sizeof(buffer) - 1 ? (uint32_t)num_chars : (uint32_t)sizeof(buffer) - 1);
+			return;
+		}
+
+		// Split the value in an integer and a rounded fractional part
+		uint64_t scale = 1;
+		for (uint32_t digit_idx = 0; digit_idx < precision; ++digit_idx)
+			scale *= 10;
+		uint64_t integer_part = (uint64_t)magnitude;
+		uint64_t fractional_part = (uint64_t)((magnitude - (double)integer_part) * (double)scale + 0.5);
+		if (fractional_part >= scale)
+		{
+			integer_part++;
+			fractional_part -= scale;
+		}
+
+		if (value < 0.0)
+			append('-');
+		append_uint(integer_part);
+		if (precision)
+		{
+			append('.');
+			// Pad the fractional part with leading zeros
+			for (uint64_t threshold = scale / 10; threshold > 1 && fractional_part < threshold; threshold /= 10)
+				append('0');
+			append_uint(fractional_part);
+		}
+	}
+
+	void StringBuilder::clear()
+	{
+		if (_first == nullptr)
+			return;
+
+		// Release everything but the first block
+		StringBuilderBlock* block = _first->next;
+		while (block != nullptr)
+		{
+			StringBuilderBlock* next = block->next;
+			_allocator.deallocate(block);
+			block = next;
+		}
+		_first->next = nullptr;
+		_first->used = 0;
+		_last = _first;
+		_size = 0;
+	}
+
+	bool StringBuilder::flush_to(int file_descriptor)
+	{
+		while (_first != nullptr)
+		{
+			// Write calls may be partial or interrupted
+			StringBuilderBlock* block = _first;
+			char* data = block_characters(block);
+			uint32_t offset = 0;
+			while (offset < block->used)
+			{
+				int64_t written = write_to_descriptor(file_descriptor, data + offset, block->used - offset);
+				if (written < 0 && errno == EINTR)
+					continue;
+				if (written <= 0)
+				{
+					// Only keep what was not written so that a retry does not write it twice
+					memmove(data, data + offset, block->used - offset);
+					block->used -= offset;
+					_size -= offset;
+					return false;
+				}
+				offset += (uint32_t)written;
+			}
+			_size -= block->used;
+			block->used = 0;
+
+			// The last block is kept for the next appends
+			if (block->next == nullptr)
+				break;
+			_first = block->next;
+			_allocator.deallocate(block);
+		}
+		return true;
+	}
+
+	void StringBuilder::finalize(DynamicString& output) const
+	{
+		assert_msg(_size < UINT32_MAX, "The content of the builder does not fit a DynamicString");
+		output.resize((uint32_t)_size);
+		char* output_data = output.c_str();
+		for (StringBuilderBlock* block = _first; block != nullptr; block = block->next)
+		{
+			memcpy(output_data, block_characters(block), block->used);
+			output_data += block->used;
+		}
+	}
+}
@@ -0,0 +1,188 @@
+// Library includes
+#include "bento_collection/string_table.h"
+#include "bento_collection/vector.h"
+#include "bento_base/hash.h"
+#include "bento_base/security.h"
+
+// External includes
+#include <mutex>
+
+namespace bento {
+
+	// Size of the arena blocks that hold the string characters
+	const uint32_t STRING_TABLE_BLOCK_SIZE = 64 * 1024;
+
+	// Initial number of slots of the hash table (must be a power of two)
+	const uint32_t STRING_TABLE_INITIAL_SLOTS = 1024;
+
+	// Header of an arena block, the characters are stored right after it
+	struct StringTableBlock
+	{
+		StringTableBlock* next;
+		uint32_t capacity;
+		uint32_t used;
+	};
+
+	// Slot of the open addressing hash table
+	struct StringTableEntry
+	{
+		StringId id;
+		const char* data;
+		uint32_t size;
+	};
+
+	class StringTable
+	{
+	public:
+		StringTable(IAllocator& allocator)
+		: _allocator(allocator)
+		, _blocks(nullptr)
+		, _entries(allocator)
+		, _num_strings(0)
+		{
+			_entries.resize(STRING_TABLE_INITIAL_SLOTS);
+			memset(_entries.begin(), 0, sizeof(StringTableEntry) * STRING_TABLE_INITIAL_SLOTS);
+		}
+
+		~StringTable()
+		{
+			while (_blocks != nullptr)
+			{
+				StringTableBlock* next = _blocks->next;
+				_allocator.deallocate(_blocks);
+				_blocks = next;
+			}
+		}
+
+		StringId intern(const StringView& str)
+		{
+			StringId id = string_table::string_id(str);
+			std::lock_guard<std::mutex> lock(_lock);
+
+			// Look for the string or the slot where it should be inserted
+			StringTableEntry& entry = find_slot(id);
+			if (entry.data != nullptr)
+			{
+				if (str != StringView(entry.data, entry.size))
+				{
+					assert_fail_msg("String id collision in the string table");
+					return INVALID_STRING_ID;
+				}
+				return id;
+			}
+
+			// Copy the characters (and the terminator) into the arena
+			char* data = allocate_characters(str.size() + 1);
+			memcpy(data, str.data(), str.size());
+			data[str.size()] = 0;
+
+			// Register the new string
+			entry.id = id;
+			entry.data = data;
+			entry.size = str.size();
+			_num_strings++;
+
+			// Keep the load factor under one half
+			if (_num_strings * 2 > _entries.size())
+				grow();
+			return id;
+		}
+
+		StringView resolve(StringId id)
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			const StringTableEntry& entry = find_slot(id);
+			return entry.data != nullptr ? StringView(entry.data, entry.size) : StringView();
+		}
+
+		uint32_t num_strings()
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			return _num_strings;
+		}
+
+	private:
+		StringTableEntry& find_slot(StringId id)
+		{
+			uint32_t mask = _entries.size() - 1;
+			uint32_t slot_idx = (uint32_t)id & mask;
+			while (_entries[slot_idx].data != nullptr && _entries[slot_idx].id != id)
+			{
+				slot_idx = (slot_idx + 1) & mask;
+			}
+			return _entries[slot_idx];
+		}
+
+		char* allocate_characters(uint32_t size)
+		{
+			if (_blocks == nullptr || _blocks->capacity - _blocks->used < size)
+			{
+				// Strings that do not fit a regular block get their own
+				uint32_t capacity = size > STRING_TABLE_BLOCK_SIZE ? size : STRING_TABLE_BLOCK_SIZE;
+				StringTableBlock* block = (StringTableBlock*)_allocator.allocate(sizeof(StringTableBlock) + capacity, 8);
+				block->capacity = capacity;
+				block->used = 0;
+				block->next = _blocks;
+				_blocks = block;
+			}
+			char* data = (char*)(_blocks + 1) + _blocks->used;
+			_blocks->used += size;
+			return data;
+		}
+
+		void grow()
+		{
+			// Move the previous slots aside
+			Vector<StringTableEntry> previous_entries(_allocator);
+			previous_entries = _entries;
+
+			// Double the table and re-insert everything
+			uint32_t num_slots = _entries.size() * 2;
+			_entries.resize(num_slots);
+			memset(_entries.begin(), 0, sizeof(StringTableEntry) * num_slots);
+			uint32_t num_previous_slots = previous_entries.size();
+			for (uint32_t slot_idx = 0; slot_idx < num_previous_slots; ++slot_idx)
+			{
+				const StringTableEntry& entry = previous_entries[slot_idx];
+				if (entry.data != nullptr)
+					find_slot(entry.id) = entry;
+			}
+		}
+
+	private:
+		IAllocator& _allocator;
+		StringTableBlock* _blocks;
+		Vector<StringTableEntry> _entries;
+		uint32_t _num_strings;
+		std::mutex _lock;
+	};
+
+	StringTable& global_string_table()
+	{
+		static StringTable __string_table(*common_allocator());
+		return __string_table;
+	}
+
+	namespace string_table
+	{
+		StringId string_id(const StringView& str)
+		{
+			return murmur_hash_64(str.data(), str.size(), 0);
+		}
+
+		StringId intern(const StringView& str)
+		{
+			return global_string_table().intern(str);
+		}
+
+		StringView resolve(StringId id)
+		{
+			return global_string_table().resolve(id);
+		}
+
+		uint32_t num_strings()
+		{
+			return global_string_table().num_strings();
+		}
+	}
+}
@@ -1,14 +1,20 @@
 // Bento includes
+#include <bento_base/checksum.h>
+#include <bento_base/log.h>
+#include <bento_base/security.h>
 #include <bento_base/stream.h>
 #include <bento_resources/asset_database.h>
 #include <bento_tools/json.hpp>
 
 namespace bento
 {
-	const uint32_t DATABASE_VERSION = 1;
+	// Version 2 adds the size and the CRC32C of the payload after the version, version 1 databases can still be read
+	const uint32_t DATABASE_VERSION = 2;
+	const uint32_t DATABASE_VERSION_NO_CHECKSUM = 1;
 
 	TAssetDatabase::TAssetDatabase(bento::IAllocator& alloc)
 	: _assets(alloc)
+	, _asset_index(alloc)
 	, allocator(alloc)
 	{
 
@@ -23,73 +29,212 @@ namespace bento
 	{
 		// Compute the new index
 		uint32_t new_asset_idx = _assets.size();
-		
-		// Create and fetch the new asset		
-		_assets.resize(new_asset_idx + 1);
-
-		// Assign the data of to the asset
-		TAsset& asset = _assets[new_asset_idx];
-		asset.id = bento::murmur_hash_64(name, string::strlen32(name), 0);
-		asset.name = name;
-		asset.path = path;
+
+		// Create the new asset and assign its data
+		TAsset& asset = _assets.extend();
+		asset.id = string_table::intern(name);
+		asset.path = string_table::intern(path);
 		asset.type = resourceType;
 		asset.data = data;
+
+		// Like the linear search this replaces, the first asset with a given name wins
+		_asset_index.insert(asset.id, new_asset_idx);
+	}
+
+	void TAssetDatabase::build_index()
+	{
+		uint32_t num_assets = _assets.size();
+		Vector<uint64_t> ids(allocator, num_assets);
+		Vector<uint32_t> indices(allocator, num_assets);
+		for (uint32_t asset_idx = 0; asset_idx < num_assets; ++asset_idx)
+		{
+			ids[asset_idx] = _assets[asset_idx].id;
+			indices[asset_idx] = asset_idx;
+		}
+		_asset_index.build(ids.begin(), indices.begin(), num_assets);
 	}
 
 	const TAsset* TAssetDatabase::request_asset(const char* name) const
 	{
-		uint64_t id = bento::murmur_hash_64(name, string::strlen32(name), 0);
-		return request_asset(id);
+		return request_asset(string_table::string_id(name));
 	}
 
 	const TAsset* TAssetDatabase::request_asset(uint64_t id) const
 	{
-		uint32_t num_assets = _assets.size();
+		const uint32_t* asset_idx = _asset_index.find(id);
+		return asset_idx != nullptr ? &_assets[*asset_idx] : nullptr;
+	}
+
+	// Interned strings are serialized the same way as a DynamicString
+	template<typename TBufferSize>
+	static void pack_interned_string(Vector<char, TBufferSize>& buffer, StringId id)
+	{
+		StringView str = string_table::resolve(id);
+		uint32_t num_chars = str.size() + 1;
+		pack_bytes(buffer, num_chars);
+		pack_buffer(buffer, num_chars, str.data());
+	}
+
+	// The characters are interned straight from the source buffer, INVALID_STRING_ID if they are truncated
+	static StringId unpack_interned_string(StreamReader& reader)
+	{
+		uint32_t num_chars;
+		reader.read_bytes(num_chars);
+		const char* chars = reader.read_view(num_chars);
+		if (chars == nullptr)
+			return INVALID_STRING_ID;
+		return string_table::intern(StringView(chars, num_chars ? num_chars - 1 : 0));
+	}
+
+	template<typename TBufferSize>
+	static void pack_asset(Vector<char, TBufferSize>& buffer, const TAsset& asset)
+	{
+		pack_bytes(buffer, asset.id);
+		pack_interned_string(buffer, asset.id);
+		pack_interned_string(buffer, asset.path);
+		pack_bytes(buffer, asset.type);
+		pack_vector_bytes(buffer, asset.data);
+	}
+
+	bool unpack_type(StreamReader& reader, TAsset& asset)
+	{
+		reader.read_bytes(asset.id);
+		StringId name_id = unpack_interned_string(reader);
+		asset.path = unpack_interned_string(reader);
+		reader.read_bytes(asset.type);
+		reader.read_vector_bytes(asset.data);
+		if (reader.failed())
+			return false;
+
+		// Malformed data, a string could not be interned or the name was not the one the id was hashed from
+		if (name_id == INVALID_STRING_ID || asset.path == INVALID_STRING_ID || name_id != asset.id)
+		{
+			reader.fail();
+			return false;
+		}
+		return true;
+	}
+
+	template<typename TBufferSize>
+	static void pack_assets(Vector<char, TBufferSize>& buffer, const TAssetDatabase& database)
+	{
+		// Same layout as pack_vector_types
+		uint32_t num_assets = database._assets.size();
+		pack_count(buffer, num_assets);
 		for (uint32_t asset_idx = 0; asset_idx < num_assets; ++asset_idx)
 		{
-			const TAsset& current_asset = _assets[asset_idx];
-			if (current_asset.id == id)
+			pack_asset(buffer, database._assets[asset_idx]);
+		}
+	}
+
+	bool unpack_assets(StreamReader& reader, TAssetDatabase& database)
+	{
+		// Every asset takes at least a byte, a larger count is corrupted
+		uint64_t num_assets = reader.read_count(UINT32_MAX);
+		if (reader.failed() || num_assets > reader.remaining())
+		{
+			bento_log_error("ASSET_DATABASE", "The database is truncated.");
+			database._assets.resize(0);
+			database._asset_index.clear();
+			return false;
+		}
+
+		database._assets.resize((uint32_t)num_assets);
+		for (uint32_t asset_idx = 0; asset_idx < num_assets; ++asset_idx)
+		{
+			if (!unpack_type(reader, database._assets[asset_idx]))
 			{
-				return &current_asset;
+				bento_log_error("ASSET_DATABASE", "The database is truncated or corrupted.");
+				database._assets.resize(0);
+				database._asset_index.clear();
+				return false;
 			}
 		}
-		return nullptr;
+		database.build_index();
+		return true;
 	}
 
-	void pack_type(Vector<char>& buffer, const TAsset& asset)
+	template<typename TBufferSize>
+	static void pack_database(Vector<char, TBufferSize>& buffer, const TAssetDatabase& database)
 	{
-		pack_bytes(buffer, asset.id);
-		pack_type(buffer, asset.name);
-		pack_type(buffer, asset.path);
-		pack_bytes(buffer, asset.type);
-		pack_vector_bytes(buffer, asset.data);
+		pack_bytes(buffer, DATABASE_VERSION);
+
+		// Reserve the payload size and checksum, they are patched once the assets are packed
+		TBufferSize header_offset = buffer.size();
+		uint32_t short_size = 0;
+		uint32_t payload_crc = 0;
+		pack_bytes(buffer, short_size);
+		pack_bytes(buffer, payload_crc);
+
+		TBufferSize payload_offset = buffer.size();
+		pack_assets(buffer, database);
+		uint64_t payload_size = buffer.size() - payload_offset;
+
+		// The size of a 4GB or larger payload is escaped like pack_count does, the header grows by 8 bytes
+		if (payload_size >= UINT32_MAX)
+		{
+			TBufferSize old_size = buffer.size();
+			buffer.resize(old_size + (TBufferSize)sizeof(uint64_t));
+			if (buffer.size() == old_size)
+				return;
+			memmove(buffer.begin() + payload_offset + sizeof(uint64_t), buffer.begin() + payload_offset, (size_t)payload_size);
+			payload_offset += (TBufferSize)sizeof(uint64_t);
+		}
+
+		payload_crc = crc32c(buffer.begin() + payload_offset, payload_size);
+		char* header = buffer.begin() + header_offset;
+		short_size = payload_size < UINT32_MAX ? (uint32_t)payload_size : UINT32_MAX;
+		memcpy(header, &short_size, sizeof(short_size));
+		header += sizeof(short_size);
+		if (short_size == UINT32_MAX)
+		{
+			memcpy(header, &payload_size, sizeof(payload_size));
+			header += sizeof(payload_size);
+		}
+		memcpy(header, &payload_crc, sizeof(payload_crc));
 	}
 
-	void unpack_type(const char*& stream, TAsset& asset)
+	void pack_type(Vector<char>& buffer, const TAssetDatabase& database)
 	{
-		unpack_bytes(stream, asset.id);
-		unpack_type(stream, asset.name);
-		unpack_type(stream, asset.path);
-		unpack_bytes(stream, asset.type);
-		unpack_vector_bytes(stream, asset.data);
+		pack_database(buffer, database);
 	}
 
-	void pack_type(Vector<char>& buffer, const TAssetDatabase& database)
+	void pack_type(Vector64<char>& buffer, const TAssetDatabase& database)
 	{
-		pack_bytes(buffer, DATABASE_VERSION);
-		pack_vector_types(buffer, database._assets);
+		pack_database(buffer, database);
 	}
 
-	bool unpack_type(const char*& stream, TAssetDatabase& database)
+	bool unpack_type(StreamReader& reader, TAssetDatabase& database)
 	{
 		// Read the version
 		uint32_t database_version;
-		unpack_bytes(stream, database_version);
+		if (!reader.read_bytes(database_version))
+			return false;
+
+		// Databases written before the checksum was added
+		if (database_version == DATABASE_VERSION_NO_CHECKSUM)
+			return unpack_assets(reader, database);
 
 		// Stop if this does not match the current version
 		if (database_version != DATABASE_VERSION) return false;
-		unpack_vector_types(stream, database._assets);
-		return true;
+
+		// Verify the payload before touching it, its size comes from the data and must fit in the buffer
+		uint64_t payload_size = reader.read_count(UINT64_MAX);
+		uint32_t payload_crc;
+		reader.read_bytes(payload_crc);
+		const char* payload = reader.read_view(payload_size);
+		if (payload == nullptr)
+		{
+			bento_log_error("ASSET_DATABASE", "The database is truncated.");
+			return false;
+		}
+		if (crc32c(payload, payload_size) != payload_crc)
+		{
+			bento_log_error("ASSET_DATABASE", "The database checksum does not match, the data is corrupted.");
+			return false;
+		}
+		StreamReader payload_reader(payload, payload_size);
+		return unpack_assets(payload_reader, database);
 	}
 
 	void to_string(DynamicString& str, const TAssetDatabase& target_database)
@@ -100,8 +245,8 @@ namespace bento
 		for (uint32_t asset_idx = 0; asset_idx < num_assets; ++asset_idx)
 		{
 			const bento::TAsset& current_asset = target_database._assets[asset_idx];
-			db[std::to_string(current_asset.id)] = { { "name", current_asset.name.c_str() },
-			{ "path", current_asset.path.c_str() },
+			db[std::to_string(current_asset.id)] = { { "name", string_table::resolve(current_asset.id).data() },
+			{ "path", string_table::resolve(current_asset.path).data() },
 			{ "type", std::to_string(current_asset.type) },
 			{ "size", current_asset.data.size() } };
 		}
@@ -1,12 +1,12 @@
 // Bento includes
 #include <bento_base/log.h>
 #include <bento_base/stream.h>
+#include <bento_collection/radix_sort.h>
 #include <bento_rt/bvh.h>
 #include <bento_rt/intersect.h>
 
 // External includes
 #include <float.h>
-#include <algorithm>
 
 namespace bento
 {
@@ -22,12 +22,20 @@ namespace bento
 			float _data;
 		};
 
-		template<typename T>
-		struct DataSorter
+		// Radix keys used to sort the primitives
+		struct PrimitiveDataKey
 		{
-			bool operator()(const T& e1, const T& e2)
+			uint32_t operator()(const PrimitiveData& data) const
 			{
-				return e1._data < e2._data;
+				return radix_sort::float_key(data._data);
+			}
+		};
+
+		struct BvhPrimitiveKey
+		{
+			uint32_t operator()(const BvhPrimitive& primitive) const
+			{
+				return primitive._data;
 			}
 		};
 
@@ -39,15 +47,23 @@ namespace bento
 			: _boxes(allocator)
 			, _boxes_split_buffer(allocator)
 			, _max_values(allocator)
+			, _max_values_scratch(allocator)
+			, _primitives_scratch(allocator)
 			{
 				_boxes.resize(num_primitives);
 				_boxes_split_buffer.resize(num_primitives);
 				_max_values.resize(num_primitives * 3);
+				_max_values_scratch.resize(num_primitives);
+				_primitives_scratch.resize(num_primitives);
 			}
 
 			Vector<Box3> _boxes;
 			Vector<Box3> _boxes_split_buffer;
 			Vector<PrimitiveData> _max_values;
+
+			// Scratch buffers of the radix sorts
+			Vector<PrimitiveData> _max_values_scratch;
+			Vector<BvhPrimitive> _primitives_scratch;
 		};
 
 		uint32_t allocate_node_array(Bvh& b, uint32_t count)
@@ -86,9 +102,10 @@ namespace bento
 				}
 
 				// Sort the max values of the entries on each dimension
-				std::sort(sh._max_values.begin(), sh._max_values.begin() + num_primitives, DataSorter<PrimitiveData>());
-				std::sort(sh._max_values.begin() + num_primitives, sh._max_values.begin() + 2 * num_primitives, DataSorter<PrimitiveData>());
-				std::sort(sh._max_values.begin() + 2 * num_primitives, sh._max_values.begin() + 3 * num_primitives, DataSorter<PrimitiveData>());
+				for (uint32_t dimension = 0; dimension < 3; ++dimension)
+				{
+					radix_sort::sort(sh._max_values.begin() + dimension * num_primitives, num_primitives, PrimitiveDataKey(), sh._max_values_scratch.begin());
+				}
 
 				// Data where that will contain the best candidate
 				Box3 final_box[2];
@@ -142,7 +159,7 @@ namespace bento
 					}
 
 					// Sort the array per owner-id in order to have them ordered for sons
-					std::sort(b.primitives.begin() + primitive_shift, b.primitives.begin() + primitive_shift + num_primitives, DataSorter<BvhPrimitive>());
+					radix_sort::sort(b.primitives.begin() + primitive_shift, num_primitives, BvhPrimitiveKey(), sh._primitives_scratch.begin());
 
 					// Allocate the children
 					uint32_t child_idx = allocate_node_array(b, 2);
@@ -167,7 +184,7 @@ namespace bento
 					current_node.max = _box.max;
 					current_node._numPrimitives = num_primitives;
 					current_node._offset = primitive_shift;
-					default_logger()->log(LogLevel::warning, "BVH", "Node is not well divided");
+					bento_log_warning("BVH", "Node is not well divided");
 				}
 			} 
 			else
@@ -244,17 +261,75 @@ namespace bento
 			return intersect_node(ray, accessor, b, 0, dist);
 		}
 
+		// Written in place of the primitive count of the original layout (no bvh has that many primitives).
+		// The nodes come first, then the primitive ids and sides bit-packed, they only need log2(num_primitives) + 1 bits.
+		// The leaves give the number of primitives the ids and sides must have.
+		const uint32_t BVH_COMPACT_MARKER = UINT32_MAX - 1;
+
 		// Serialization and Deserialization functions
-		void pack(Vector<char>& buffer, const Bvh& b)
+		template<typename TBufferSize>
+		static void pack_bvh(Vector<char, TBufferSize>& buffer, const Bvh& b)
 		{
-			pack_vector_bytes(buffer, b.primitives);
+			uint32_t num_primitives = b.primitives.size();
+			Vector<uint32_t> values(*b.primitives._allocator, num_primitives);
+			pack_bytes(buffer, BVH_COMPACT_MARKER);
 			pack_vector_bytes(buffer, b.nodes);
+			for (uint32_t primitive_idx = 0; primitive_idx < num_primitives; ++primitive_idx)
+				values[primitive_idx] = b.primitives[primitive_idx]._primitiveID;
+			pack_bit_packed(buffer, values.begin(), num_primitives);
+			for (uint32_t primitive_idx = 0; primitive_idx < num_primitives; ++primitive_idx)
+				values[primitive_idx] = b.primitives[primitive_idx]._data;
+			pack_bit_packed(buffer, values.begin(), num_primitives);
+		}
+
+		void pack(Vector<char>& buffer, const Bvh& b)
+		{
+			pack_bvh(buffer, b);
+		}
+
+		void pack(Vector64<char>& buffer, const Bvh& b)
+		{
+			pack_bvh(buffer, b);
 		}
 		
 		void unpack(const char *& buffer, Bvh& b)
 		{
-			unpack_vector_bytes(buffer, b.primitives);
-			unpack_vector_bytes(buffer, b.nodes);
+			// Bvhs written before the compact layout start with their primitive count
+			uint32_t marker;
+			const char* stream = buffer;
+			unpack_bytes(stream, marker);
+			if (marker != BVH_COMPACT_MARKER)
+			{
+				unpack_vector_bytes(buffer, b.primitives);
+				unpack_vector_bytes(buffer, b.nodes);
+				return;
+			}
+
+			unpack_vector_bytes(stream, b.nodes);
+			uint64_t num_leaf_primitives = 0;
+			uint32_t num_nodes = b.nodes.size();
+			for (uint32_t node_idx = 0; node_idx < num_nodes; ++node_idx)
+				num_leaf_primitives += b.nodes[node_idx]._numPrimitives;
+
+			Vector<uint32_t> ids(*b.primitives._allocator);
+			Vector<uint32_t> sides(*b.primitives._allocator);
+			uint32_t num_primitives = num_leaf_primitives < UINT32_MAX ? (uint32_t)num_leaf_primitives : UINT32_MAX;
+			unpack_bit_packed(stream, ids, num_primitives);
+			unpack_bit_packed(stream, sides, num_primitives);
+			if (num_leaf_primitives != ids.size() || ids.size() != sides.size())
+			{
+				bento_log_error("BVH", "The primitives of the bvh don't match its leaves.");
+				b.primitives.clear();
+				b.nodes.clear();
+				return;
+			}
+			b.primitives.resize(num_primitives);
+			for (uint32_t primitive_idx = 0; primitive_idx < num_primitives; ++primitive_idx)
+			{
+				b.primitives[primitive_idx]._primitiveID = ids[primitive_idx];
+				b.primitives[primitive_idx]._data = (uint8_t)sides[primitive_idx];
+			}
+			buffer = stream;
 		}
 	}
 }
\ No newline at end of file
@@ -1,31 +1,76 @@
 // SDK includes
 #include "bento_tools/disk_serializer.h"
+#include "bento_base/checksum.h"
+#include "bento_base/log.h"
 
 namespace bento {
+
+	// "BNTO" followed by the CRC32C of the payload (4 bytes) and its size (8 bytes)
+	const uint32_t BINARY_FILE_MAGIC = 0x4F544E42;
 	DiskSerializer::DiskSerializer(IAllocator& allocator, const char* root)
 	: _allocator(allocator)
 	, _root(allocator, root)
 	{
 	}
 
-	bool DiskSerializer::internal_write_buffer(const Vector<char>& buffer, const char *name, const char* extension)
+	bool DiskSerializer::internal_write_buffer(Vector<char>& buffer, const char *name, const char* extension)
 	{	
 		// Create the final path of the buffers
 		DynamicString total_path = path::join(_root.c_str(), name, _allocator);
 		total_path = path::add_extension(total_path.c_str(), extension, _allocator);
 
+		// Fill the header that was reserved in front of the payload
+		uint64_t payload_size = buffer.size() - BINARY_FILE_HEADER_SIZE;
+		uint32_t payload_crc = crc32c(buffer.begin() + BINARY_FILE_HEADER_SIZE, payload_size);
+		memcpy(buffer.begin(), &BINARY_FILE_MAGIC, sizeof(uint32_t));
+		memcpy(buffer.begin() + 4, &payload_crc, sizeof(uint32_t));
+		memcpy(buffer.begin() + 8, &payload_size, sizeof(uint64_t));
+
 		// Write the target buffer
 		return write_file(total_path.c_str(), buffer.begin(), buffer.size(), FileType::Binary);
 	}
 
-	bool DiskSerializer::internal_read_buffer(Vector<char>& buffer, const char *name, const char* extension)
+	bool DiskSerializer::internal_read_buffer(Vector<char>& buffer, const char *name, const char* extension, const char*& payload, uint64_t& payload_size)
 	{
 		// Create the final path of the buffers
 		DynamicString total_path = path::join(_root.c_str(), name, _allocator);
 		total_path = path::add_extension(total_path.c_str(), extension, _allocator);
 
 		// Write the target buffer
-		return read_file(total_path.c_str(), buffer, FileType::Binary);
+		if (!read_file(total_path.c_str(), buffer, FileType::Binary))
+			return false;
+
+		// Files written before the header was added are read as they are
+		uint32_t magic = 0;
+		if (buffer.size() >= sizeof(uint32_t))
+			memcpy(&magic, buffer.begin(), sizeof(uint32_t));
+		if (magic != BINARY_FILE_MAGIC)
+		{
+			payload = buffer.begin();
+			payload_size = buffer.size();
+			return true;
+		}
+
+		// Verify the size and the checksum of the payload
+		uint32_t payload_crc = 0;
+		payload_size = 0;
+		if (buffer.size() >= BINARY_FILE_HEADER_SIZE)
+		{
+			memcpy(&payload_crc, buffer.begin() + 4, sizeof(uint32_t));
+			memcpy(&payload_size, buffer.begin() + 8, sizeof(uint64_t));
+		}
+		payload = buffer.begin() + BINARY_FILE_HEADER_SIZE;
+		if (buffer.size() < BINARY_FILE_HEADER_SIZE || payload_size != buffer.size() - BINARY_FILE_HEADER_SIZE)
+		{
+			bento_log_error("DISK_SERIALIZER", "The file is truncated.");
+			return false;
+		}
+		if (crc32c(payload, payload_size) != payload_crc)
+		{
+			bento_log_error("DISK_SERIALIZER", "The file checksum does not match, the data is corrupted.");
+			return false;
+		}
+		return true;
 	}
 
 	bool DiskSerializer::internal_write_string(const DynamicString& str, const char *name, const char* extension)
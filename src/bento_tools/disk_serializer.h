@@ -2,11 +2,18 @@
 
 // SDK includes
 #include "bento_memory/common.h"
+#include "bento_base/stream.h"
 #include "bento_collection/dynamic_string.h"
 #include "bento_tools/file_system.h"
 
+// External includes
+#include <utility>
+
 namespace bento {
 
+	// Binary files start with a magic number, the CRC32C and the size of the payload
+	const uint32_t BINARY_FILE_HEADER_SIZE = 16;
+
 	class DiskSerializer
 	{
 		ALLOCATOR_BASED;
@@ -18,20 +25,25 @@ namespace bento {
 		template<typename T>
 		bool write_binary(const T& entry, const char* name, const char* extension)
 		{
+			// Leave room for the header, it is filled once the payload is packed
 			Vector<char> buffer(_allocator);
+			buffer.resize(BINARY_FILE_HEADER_SIZE);
 			pack_type(buffer, entry);
 			return internal_write_buffer(buffer, name, extension);
 		}
 
-		// Function that fills an entry from a binary file
+		// Function that fills an entry from a binary file, fails if the file is truncated or corrupted.
+		// Types with a bool unpack_type(StreamReader&, T&) are read through a reader bounded by the file size, the other
+		// ones use their unpack_type(const char*&, T&) and fail if it went past the end of the payload.
 		template<typename T>
 		bool read_binary(T& entry, const char* name, const char* extension)
 		{
 			Vector<char> buffer(_allocator);
-			bool buffer_read = internal_read_buffer(buffer, name, extension);
+			const char* payload = nullptr;
+			uint64_t payload_size = 0;
+			bool buffer_read = internal_read_buffer(buffer, name, extension, payload, payload_size);
 			if (!buffer_read) return false;
-			const char* stream = buffer.begin();
-			return unpack_type(stream, entry);
+			return unpack_payload(payload, payload_size, entry, 0);
 		}
 
 		template<typename T>
@@ -52,8 +64,25 @@ namespace bento {
 		}
 
 	private:
-		bool internal_write_buffer(const Vector<char>& buffer, const char *name, const char* extension);
-		bool internal_read_buffer(Vector<char>& buffer, const char *name, const char* extension);
+		// Picked when the type has a bounded unpack_type
+		template<typename T>
+		static auto unpack_payload(const char* payload, uint64_t payload_size, T& entry, int) -> decltype(unpack_type(std::declval<StreamReader&>(), entry))
+		{
+			StreamReader reader(payload, payload_size);
+			return unpack_type(reader, entry);
+		}
+
+		// The legacy unpack_type can't be stopped at the end of the payload, going past it is reported once it returns
+		template<typename T>
+		static bool unpack_payload(const char* payload, uint64_t payload_size, T& entry, long)
+		{
+			const char* stream = payload;
+			unpack_type(stream, entry);
+			return (uint64_t)(stream - payload) <= payload_size;
+		}
+
+		bool internal_write_buffer(Vector<char>& buffer, const char *name, const char* extension);
+		bool internal_read_buffer(Vector<char>& buffer, const char *name, const char* extension, const char*& payload, uint64_t& payload_size);
 
 		bool internal_write_string(const DynamicString& str, const char *name, const char* extension);
 		bool internal_read_string(DynamicString& str, const char *name, const char* extension);
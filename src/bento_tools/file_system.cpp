@@ -15,82 +15,92 @@ namespace bento {
 	namespace path {
 
 		// Joing a root path with a sub-path
-		inline DynamicString internal_join(const char* root, const char* sub_path, const char separator, IAllocator& allocator)
-		{	
+		inline void internal_join(const StringView& root, const StringView& sub_path, const char separator, DynamicString& output)
+		{
 			// Compute the path lengths
-			uint32_t root_length = string::strlen32(root);
-			uint32_t subpath_length = string::strlen32(sub_path);
-			uint32_t required_size = root_length + 1 + subpath_length;
+			uint32_t root_length = root.size();
+			uint32_t subpath_length = sub_path.size();
 
-			// Create the output container
-			DynamicString result(allocator, required_size);
+			// Resize the output container (its memory is reused if big enough)
+			output.resize(root_length + 1 + subpath_length);
 
 			// Fetch the raw buffer
-			char* raw_buffer = result.c_str();
+			char* raw_buffer = output.c_str();
 
 			// Copy the sub_paths
-			memcpy(raw_buffer, root, root_length);
+			memcpy(raw_buffer, root.data(), root_length);
 			raw_buffer[root_length] = separator;
-			memcpy(raw_buffer + root_length + 1, sub_path, subpath_length);
-
-			// We are done
-			return result;
+			memcpy(raw_buffer + root_length + 1, sub_path.data(), subpath_length);
 		}
-		
+
 		DynamicString join(const char* root, const char* sub_path, IAllocator& allocator)
 		{
-			return internal_join(root, sub_path, PATH_SEPARATOR, allocator);
+			DynamicString result(allocator);
+			internal_join(root, sub_path, PATH_SEPARATOR, result);
+			return result;
 		}
 
 		DynamicString add_extension(const char *path, const char *extension, IAllocator& allocator)
 		{
-			return internal_join(path, extension, EXTENSION_SEPARATOR, allocator);
+			DynamicString result(allocator);
+			internal_join(path, extension, EXTENSION_SEPARATOR, result);
+			return result;
 		}
 
 		DynamicString strip_extension(const char *file_path, IAllocator& allocator)
 		{
-			uint32_t separator = string::find_last_of(file_path, EXTENSION_SEPARATOR);
-			DynamicString result(allocator, separator);
-			if(separator) {
-				memcpy(result.c_str(), file_path, separator);
-			}
-			return result;
+			return DynamicString(allocator, strip_extension(StringView(file_path)));
 		}
 
 		DynamicString extension(const char *file_path, IAllocator& allocator)
 		{
-			uint32_t path_size = string::strlen32(file_path);
-			uint32_t separator = string::find_last_of(file_path, EXTENSION_SEPARATOR);
-			DynamicString result(allocator, path_size  - separator);
-			uint32_t extension_size = path_size  - separator;
-			if(extension_size) {
-				memcpy(result.c_str(), file_path + separator + 1, extension_size);
-			}
-			return result;
+			return DynamicString(allocator, extension(StringView(file_path)));
 		}
 
 		DynamicString directory(const char *file_path, IAllocator& allocator)
 		{
-			uint32_t separator = string::find_last_of(file_path, PATH_SEPARATOR);
-			DynamicString result(allocator, separator);
-			if(separator) {
-				memcpy(result.c_str(), file_path, separator);
-			}
-			return result;
+			return DynamicString(allocator, directory(StringView(file_path)));
 		}
 
 		DynamicString filename(const char *file_path, IAllocator& allocator)
 		{
-			uint32_t path_size = string::strlen32(file_path);
+			return DynamicString(allocator, filename(StringView(file_path)));
+		}
+
+		void join(const StringView& root, const StringView& sub_path, DynamicString& output)
+		{
+			internal_join(root, sub_path, PATH_SEPARATOR, output);
+		}
+
+		StringView strip_extension(const StringView& file_path)
+		{
+			uint32_t separator = string::find_last_of(file_path, EXTENSION_SEPARATOR);
+			return StringView(file_path.data(), separator);
+		}
+
+		StringView extension(const StringView& file_path)
+		{
+			uint32_t path_size = file_path.size();
+			uint32_t separator = string::find_last_of(file_path, EXTENSION_SEPARATOR);
+			if (separator == path_size)
+				return StringView();
+			return string::substr(file_path, separator + 1, path_size - separator - 1);
+		}
+
+		StringView directory(const StringView& file_path)
+		{
+			uint32_t separator = string::find_last_of(file_path, PATH_SEPARATOR);
+			return StringView(file_path.data(), separator);
+		}
+
+		StringView filename(const StringView& file_path)
+		{
+			uint32_t path_size = file_path.size();
 			uint32_t dir_separator = string::find_last_of(file_path, PATH_SEPARATOR);
-			dir_separator = dir_separator != path_size ? dir_separator : 0;
+			uint32_t first_idx = dir_separator != path_size ? dir_separator + 1 : 0;
 			uint32_t extension = string::find_last_of(file_path, EXTENSION_SEPARATOR);
-			uint32_t filename_size = extension - dir_separator - 1;
-			DynamicString result(allocator, filename_size);
-			if(filename_size){
-				memcpy(result.c_str(), file_path + dir_separator + 1, filename_size);
-			}
-			return result;
+			uint32_t last_idx = (extension != path_size && extension >= first_idx) ? extension : path_size;
+			return string::substr(file_path, first_idx, last_idx - first_idx);
 		}
 	}
 
@@ -111,11 +121,15 @@ namespace bento {
 
 	        if (! directory) 
 	        {
-				default_logger()->log(LogLevel::error, "FILE_SYSTEM", "Error in directory.");
+				bento_log_error("FILE_SYSTEM", "Error in directory.");
 				return;
 	        }
 
-	        uint32_t extensionSize = (uint32_t)strlen(target_extension);
+	        StringView root_view(root_path);
+	        StringView extension_view(target_extension);
+
+	        // The absolute path buffer is shared by all the entries of this directory
+	        DynamicString absolute_path(*common_allocator());
 
 	        // For each entry in the directory
 	        while (1) 
@@ -130,24 +144,21 @@ namespace bento {
 	            }
 
 	            // Get its filename
-	            DynamicString entry_name(*common_allocator(), newEntry->d_name);
+	            StringView entry_name(newEntry->d_name);
 
 	            // Reject dummy entries
 	            if((entry_name=="..") || (entry_name=="."))
 	            {
 	                continue;
 	            }
-				DynamicString absolute_path(*common_allocator(), root_path);
-	            absolute_path += "/";
-	            absolute_path += entry_name;
+	            path::join(root_view, entry_name, absolute_path);
 
 	            // Check if the entry is a directory or not
 	            bool is_file = path_is_file(absolute_path.c_str());
 
 	            if(is_file)
 	            {
-					const DynamicString& extension = path::extension(entry_name.c_str(), *common_allocator());
-	            	if( entry_name.size() < extensionSize || extension != target_extension)
+	            	if(path::extension(entry_name) != extension_view)
 		            {
 		                continue;
 		            }
@@ -164,14 +175,14 @@ namespace bento {
 
 	        if (closedir (directory)) 
 	        {
-				default_logger()->log(LogLevel::error, "FILE_SYSTEM", "Error while closing directory.");
+				bento_log_error("FILE_SYSTEM", "Error while closing directory.");
 	            return;
 	        }
 		}
 	}
 
 	// Write a buffer to a file
-	bool write_file(const char *file_name, const char *buffer, uint32_t buffer_size, FileType type)
+	bool write_file(const char *file_name, const char *buffer, uint64_t buffer_size, FileType type)
 	{	
 		bool success = false;
 		if (file_name != nullptr) {
@@ -179,7 +190,7 @@ namespace bento {
 			FILE* file_pointer = fopen(file_name, open_mode);
 			if (file_pointer != nullptr) {
 				// Write and ensure everything has been written
-				if (fwrite(buffer, sizeof(char), buffer_size, file_pointer) == buffer_size)
+				if (fwrite(buffer, sizeof(char), (size_t)buffer_size, file_pointer) == buffer_size)
 					success = true;
 				// Close the target file
 				fclose(file_pointer);
@@ -188,24 +199,52 @@ namespace bento {
 		return success;
 	}
 
-	bool read_file(const char *file_name, Vector<char>& buffer, FileType type)
+	// 64 bit file offsets
+	inline int64_t file_size(FILE* file_pointer)
+	{
+	#if defined(WINDOWSPC)
+		_fseeki64(file_pointer, 0, SEEK_END);
+		int64_t size = _ftelli64(file_pointer);
+		_fseeki64(file_pointer, 0, SEEK_SET);
+	#else
+		fseeko(file_pointer, 0, SEEK_END);
+		int64_t size = ftello(file_pointer);
+		fseeko(file_pointer, 0, SEEK_SET);
+	#endif
+		return size;
+	}
+
+	template<typename TSize>
+	bool read_file_internal(const char *file_name, Vector<char, TSize>& buffer, FileType type)
 	{
 		bool success = false;
 		if (file_name != nullptr) {
 			const char * open_mode = "rb";
 			FILE* file_pointer = fopen(file_name, open_mode);
 			if (file_pointer != nullptr) {
-				fseek(file_pointer, 0L, SEEK_END);
-				int buffer_size = ftell(file_pointer);
-				fseek(file_pointer, 0L, SEEK_SET);
-				buffer.resize(buffer_size);
-				if (fread(buffer.begin(), sizeof(char), buffer_size, file_pointer) == buffer_size)
-					success = true;
+				int64_t buffer_size = file_size(file_pointer);
+
+				// Make sure the file (and its terminator) fits in the buffer
+				if (buffer_size >= 0 && (uint64_t)buffer_size < (uint64_t)(TSize)~(TSize)0) {
+					buffer.resize((TSize)buffer_size);
+					if (fread(buffer.begin(), sizeof(char), (size_t)buffer_size, file_pointer) == (size_t)buffer_size)
+						success = true;
+					// If this is supposed to be read as a string, we need to add an end chracter
+					if (type == FileType::Text) buffer.push_back('\0');
+				}
 				fclose(file_pointer);
-				// If this is supposed to be read as a string, we need to add an end chracter
-				if (type == FileType::Text) buffer.push_back('\0');
 			}
 		}
 		return success;
 	}
+
+	bool read_file(const char *file_name, Vector<char>& buffer, FileType type)
+	{
+		return read_file_internal(file_name, buffer, type);
+	}
+
+	bool read_file(const char *file_name, Vector64<char>& buffer, FileType type)
+	{
+		return read_file_internal(file_name, buffer, type);
+	}
 }
\ No newline at end of file
@@ -1,15 +1,33 @@
 // bento includes
 #include "bento_tools/statistics.h"
+#include "bento_collection/radix_sort.h"
 
 // system includes
-#include <algorithm>
+#include <math.h>
 
 namespace bento
 {
+	// Radix keys that sort the samples in decreasing order
+	struct DescendingU64Key
+	{
+		uint64_t operator()(uint64_t value) const
+		{
+			return ~value;
+		}
+	};
+
+	struct DescendingFloatKey
+	{
+		uint32_t operator()(float value) const
+		{
+			return ~radix_sort::float_key(value);
+		}
+	};
+
     void evaluate_avg_med_stddev(uint64_t* first, uint64_t* end, uint64_t numElements, uint64_t& average, uint64_t& median, uint64_t& standardDeviation)
     {
 	    // Sort the timings
-	    std::sort(first, end, std::greater<uint64_t>());
+	    radix_sort::sort(first, (uint32_t)(end - first), DescendingU64Key(), *common_allocator());
 
 		// Pick the median
 		median = first[numElements / 2];
@@ -34,7 +52,7 @@ namespace bento
     void evaluate_avg_med_stddev(float* first, float* end, uint64_t numElements, float& average, float& median, float& standardDeviation)
     {
 	    // Sort the timings
-	    std::sort(first, end, std::greater<float>());
+	    radix_sort::sort(first, (uint32_t)(end - first), DescendingFloatKey(), *common_allocator());
 
 		// Pick the median
 		median = first[numElements / 2];